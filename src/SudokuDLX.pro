@@ -1,4 +1,4 @@
-QT += core gui
+QT += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -7,15 +7,13 @@ TEMPLATE = app
 
 DEFINES += QT_DEPRECATED_WARNINGS
 
-CONFIG += c++11
+include(core.pri)
 
 SOURCES += \
-    dlx.cpp \
     main.cpp \
     mainwindow.cpp
 
 HEADERS += \
-    dlx.h \
     mainwindow.h \
     tests.h
 
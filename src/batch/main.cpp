@@ -0,0 +1,342 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QMutex>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <QDebug>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include "bitboardsolver.h"
+#include "dlx.h"
+#include "gridformat.h"
+#include "puzzlefile.h"
+#include "solutioncache.h"
+
+// Number of puzzles a worker claims at once (reduces contention on shared counter)
+static const int ChunkSize = 64;
+// Number of solved chunks per worker that may wait to be written (lets workers run ahead of a slow chunk)
+static const int BufferedChunksPerWorker = 2;
+
+// Solvers of a single worker (reused between puzzles), engine picked per puzzle by grid size
+struct WorkerSolvers {
+    Solver::Engine engine;
+    DLX dlx{Grid()};
+    BitboardSolver bitboard;
+
+    WorkerSolvers(Solver::Engine engine, bool propagation, const Solver::Budget &budget, const DLX::Heuristic &heuristic,
+                  SolutionCache *cache) : engine(engine) {
+        dlx.setPropagation(propagation);
+        bitboard.setPropagation(propagation);
+        dlx.setBudget(budget);
+        bitboard.setBudget(budget);
+        dlx.setHeuristic(heuristic);
+        dlx.setCache(cache);
+    }
+
+    // Selected engine if it supports grid size, DLX otherwise
+    Solver &forSize(int size) {
+        if (engine == Solver::Bitboard && Solver::supports(engine, size)) {
+            return bitboard;
+        }
+        return dlx;
+    }
+};
+
+// Loads i-th puzzle into one of worker's solvers, returns that solver or nullptr if puzzle is invalid
+using PuzzleLoader = std::function<Solver *(WorkerSolvers &solvers, qint64 i)>;
+
+// Reads puzzles in dotted string or delimited format (one per line, blank lines skipped)
+static bool readPuzzles(const QString &fileName, QStringList &puzzles) {
+    QFile file;
+    bool opened;
+    if (fileName == "-") {
+        opened = file.open(stdin, QIODevice::ReadOnly | QIODevice::Text);
+    } else {
+        file.setFileName(fileName);
+        opened = file.open(QIODevice::ReadOnly | QIODevice::Text);
+    }
+
+    if (!opened) {
+        qCritical() << "Failed to open" << fileName;
+        return false;
+    }
+
+    QTextStream in(&file);
+    QString line;
+    while (in.readLineInto(&line)) {
+        line = line.trimmed();
+        if (!line.isEmpty()) {
+            puzzles.append(line);
+        }
+    }
+
+    return true;
+}
+
+// Parses heuristic name (mrv, random, degree or random-degree), returns false if unknown
+static bool parseHeuristic(const QString &name, DLX::Heuristic &heuristic) {
+    if (name != "mrv" && name != "random" && name != "degree" && name != "random-degree") {
+        return false;
+    }
+    heuristic.randomTieBreak = name.startsWith("random");
+    heuristic.degreeOrder = name.endsWith("degree");
+    return true;
+}
+
+// Solves all puzzles across threads, each with its own solver instances (reused between puzzles)
+// Portfolio above 1 races that many differently randomized searches per DLX puzzle (threads are divided between them)
+// Cache (shared by all workers, nullptr for none) answers DLX solves of puzzles already solved in any transformed variant
+// Results are streamed to output in input order as chunks complete: solution, 'none' if no solution,
+// 'exhausted' if budget ran out or 'invalid' if not NxN grid
+static qint64 solvePuzzles(qint64 count, const PuzzleLoader &load, QTextStream &out, int threads,
+                        Solver::Engine engine, bool propagation, const Solver::Budget &budget,
+                        const DLX::Heuristic &heuristic, int portfolio, SolutionCache *cache) {
+    int workers = qMax(1, threads / qMax(1, portfolio));
+    qint64 chunks = (count + ChunkSize - 1) / ChunkSize;
+
+    // Ring of chunk buffers, chunk c is kept in slot c % ring size until written (bounds results held in memory)
+    QVector<QVector<QString>> ring(workers * BufferedChunksPerWorker);
+    QVector<QString> *slots = ring.data(); // Detach once, workers fill disjoint slots
+    QVector<bool> ready(ring.size(), false);
+    qint64 written = 0;
+    QMutex mutex; // Guards ready and written
+    QWaitCondition chunkReady;
+    QWaitCondition slotWritten;
+
+    std::atomic<qint64> nextChunk(0);
+    std::atomic<qint64> solvedCount(0);
+
+    auto worker = [&]() {
+        WorkerSolvers solvers(engine, propagation, budget, heuristic, cache);
+
+        qint64 chunk;
+        while ((chunk = nextChunk.fetch_add(1)) < chunks) {
+            // Wait until slot is free (previous chunk in it written), chunk being written never waits on its own
+            int slot = static_cast<int>(chunk % ring.size());
+            {
+                QMutexLocker locker(&mutex);
+                while (chunk >= written + ring.size()) {
+                    slotWritten.wait(&mutex);
+                }
+            }
+
+            qint64 start = chunk * ChunkSize;
+            qint64 end = qMin(start + ChunkSize, count);
+            QVector<QString> &output = slots[slot];
+            output.resize(static_cast<int>(end - start));
+            for (qint64 i = start; i < end; ++i) {
+                Solver *solver = load(solvers, i);
+                if (!solver) {
+                    output[i - start] = "invalid";
+                } else if ((portfolio > 1 && solver == &solvers.dlx) ? solvers.dlx.solvePortfolio(portfolio) : solver->solve()) {
+                    output[i - start] = GridFormat::toString(solver->solution());
+                    ++solvedCount;
+                } else {
+                    output[i - start] = Solver::resultName(solver->result());
+                }
+            }
+
+            QMutexLocker locker(&mutex);
+            ready[slot] = true;
+            chunkReady.wakeAll();
+        }
+    };
+
+    QList<std::thread *> pool;
+    for (int i = 0; i < workers; ++i) {
+        pool.append(new std::thread(worker));
+    }
+
+    // Write chunks in order on calling thread while workers solve following ones
+    for (qint64 chunk = 0; chunk < chunks; ++chunk) {
+        int slot = static_cast<int>(chunk % ring.size());
+        QMutexLocker locker(&mutex);
+        while (!ready.at(slot)) {
+            chunkReady.wait(&mutex);
+        }
+        locker.unlock();
+
+        for (auto &result : ring.at(slot)) {
+            out << result << '\n';
+        }
+
+        locker.relock();
+        ready[slot] = false;
+        ++written;
+        slotWritten.wakeAll();
+    }
+
+    for (auto &thread : pool) {
+        thread->join();
+        delete thread;
+    }
+
+    return solvedCount;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SudokuDLXBatch");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless batch Sudoku solver (Dancing Links or 9x9 bitboard).\n"
+                                     "Reads puzzles in dotted string format (53.2..4..., values above 9 as A-Z, a-z)\n"
+                                     "or delimited format (5,3,.,2,...), one per line,\n"
+                                     "or packed binary puzzle files (memory-mapped).");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Input files ('-' or none for standard input).", "[files...]");
+    QCommandLineOption threadsOption({"j", "threads"}, "Number of worker threads (default: all cores).", "count");
+    QCommandLineOption outputOption({"o", "output"}, "Output file (default: standard output).", "file");
+    QCommandLineOption engineOption({"e", "engine"}, "Solving engine: dlx or bitboard (9x9 only, DLX used for other sizes) (default: dlx).", "engine", "dlx");
+    parser.addOption(threadsOption);
+    parser.addOption(outputOption);
+    QCommandLineOption propagateOption("propagate", "Run constraint propagation pre-pass (naked and hidden singles) before search.");
+    QCommandLineOption nodeLimitOption("node-limit", "Search nodes per puzzle, reports 'exhausted' if exceeded (default: no limit).", "nodes", "0");
+    QCommandLineOption timeLimitOption("time-limit", "Search milliseconds per puzzle, reports 'exhausted' if exceeded (default: no limit).", "ms", "0");
+    QCommandLineOption heuristicOption("heuristic", "DLX branching heuristic: mrv (leftmost column with fewest rows), random (random tie-break),\n"
+                                                    "degree (least constraining rows first) or random-degree (default: mrv).", "name", "mrv");
+    QCommandLineOption seedOption("seed", "Seed of random tie-break (default: 0).", "seed", "0");
+    QCommandLineOption portfolioOption("portfolio", "Races given number of differently randomized DLX searches per puzzle,\n"
+                                                    "first to finish decides (worker threads are divided between them) (default: off).", "count", "0");
+    QCommandLineOption cacheOption("cache", "Caches results of up to given number of puzzles, also answering transformed variants\n"
+                                            "(relabeled digits, permuted lines, transposed) (default: off).", "entries", "0");
+    QCommandLineOption cacheFileOption("cache-file", "Keeps cache in file between runs (enables cache, default size 100000).", "file");
+    parser.addOption(engineOption);
+    parser.addOption(propagateOption);
+    parser.addOption(nodeLimitOption);
+    parser.addOption(timeLimitOption);
+    parser.addOption(heuristicOption);
+    parser.addOption(seedOption);
+    parser.addOption(portfolioOption);
+    parser.addOption(cacheOption);
+    parser.addOption(cacheFileOption);
+    parser.process(app);
+
+    Solver::Engine engine;
+    if (parser.value(engineOption) == Solver::engineName(Solver::Bitboard)) {
+        engine = Solver::Bitboard;
+    } else if (parser.value(engineOption) == Solver::engineName(Solver::DancingLinks)) {
+        engine = Solver::DancingLinks;
+    } else {
+        qCritical() << "Unknown engine" << parser.value(engineOption);
+        return 1;
+    }
+
+    Solver::Budget budget;
+    budget.nodes = parser.value(nodeLimitOption).toULongLong();
+    budget.milliseconds = qMax<qint64>(0, parser.value(timeLimitOption).toLongLong());
+
+    DLX::Heuristic heuristic;
+    if (!parseHeuristic(parser.value(heuristicOption), heuristic)) {
+        qCritical() << "Unknown heuristic" << parser.value(heuristicOption);
+        return 1;
+    }
+    heuristic.seed = parser.value(seedOption).toULongLong();
+    int portfolio = qMax(0, parser.value(portfolioOption).toInt());
+
+    // Cache shared by all workers and files
+    QScopedPointer<SolutionCache> cache;
+    int cacheEntries = parser.value(cacheOption).toInt();
+    if (cacheEntries > 0 || parser.isSet(cacheFileOption)) {
+        cache.reset(new SolutionCache(cacheEntries > 0 ? cacheEntries : SolutionCache::DefaultCapacity));
+        if (parser.isSet(cacheFileOption) && !cache->open(parser.value(cacheFileOption))) {
+            qCritical() << "Failed to open" << parser.value(cacheFileOption);
+            return 1;
+        }
+    }
+
+    int threads = QThread::idealThreadCount();
+    if (parser.isSet(threadsOption)) {
+        threads = qMax(1, parser.value(threadsOption).toInt());
+    }
+
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        files.append("-");
+    }
+
+    // Open output
+    QFile outFile;
+    bool opened;
+    if (parser.isSet(outputOption)) {
+        outFile.setFileName(parser.value(outputOption));
+        opened = outFile.open(QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = outFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+
+    if (!opened) {
+        qCritical() << "Failed to open output";
+        return 1;
+    }
+
+    QTextStream out(&outFile);
+
+    // Solve file by file, streaming results in input order
+    qint64 total = 0;
+    qint64 solved = 0;
+    double bench = 0.0;
+
+    for (auto &fileName : files) {
+        QStringList puzzles;
+        PuzzleFile puzzleFile;
+        qint64 count;
+        PuzzleLoader load;
+
+        if (fileName != "-" && PuzzleFile::isPuzzleFile(fileName)) {
+            // Packed binary, solver reads directly from mapped file
+            if (!puzzleFile.open(fileName)) {
+                qCritical() << "Failed to open" << fileName;
+                return 1;
+            }
+
+            count = puzzleFile.count();
+            load = [&puzzleFile](WorkerSolvers &solvers, qint64 i) {
+                Solver &solver = solvers.forSize(puzzleFile.size());
+                solver.reset(puzzleFile.puzzle(i));
+                return &solver;
+            };
+        } else {
+            // Dotted string or delimited format
+            if (!readPuzzles(fileName, puzzles)) {
+                return 1;
+            }
+
+            count = puzzles.size();
+            load = [&puzzles](WorkerSolvers &solvers, qint64 i) -> Solver * {
+                Grid sudoku = GridFormat::fromString(puzzles.at(static_cast<int>(i)));
+                if (sudoku.isEmpty()) {
+                    return nullptr;
+                }
+                Solver &solver = solvers.forSize(sudoku.size());
+                solver.reset(sudoku);
+                return &solver;
+            };
+        }
+
+        auto benchStart = std::chrono::high_resolution_clock::now();
+        solved += solvePuzzles(count, load, out, threads, engine, parser.isSet(propagateOption), budget, heuristic, portfolio, cache.data());
+        auto benchEnd = std::chrono::high_resolution_clock::now();
+        bench += std::chrono::duration<double>(benchEnd - benchStart).count();
+        total += count;
+    }
+    out.flush();
+
+    qInfo().noquote() << QString("Solved %1/%2 puzzles in %3 seconds on %4 threads (%5 puzzles/second)")
+                         .arg(solved).arg(total).arg(bench).arg(threads)
+                         .arg(bench > 0.0 ? total / bench : 0.0);
+    if (cache) {
+        qInfo().noquote() << QString("Cache: %1 hits, %2 misses, %3 entries").arg(cache->hits()).arg(cache->misses()).arg(cache->size());
+    }
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+QT += core
+QT -= gui
+
+TARGET = SudokuDLXBenchmark
+TEMPLATE = app
+
+CONFIG += console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+include(../core.pri)
+
+SOURCES += \
+    main.cpp
+
+HEADERS += \
+    ../tests.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
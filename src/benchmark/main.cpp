@@ -0,0 +1,282 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QScopedPointer>
+#include <QTextStream>
+
+#include <QDebug>
+
+#include <algorithm>
+
+#include "gridformat.h"
+#include "puzzlefile.h"
+#include "solver.h"
+#include "tests.h"
+
+struct PuzzleSet {
+    QString name;
+    QList<Grid> puzzles;
+};
+
+// Per-solve phase durations in microseconds
+struct Samples {
+    QVector<double> propagate;
+    QVector<double> build;
+    QVector<double> cover;
+    QVector<double> search;
+    QVector<double> total;
+    int solved = 0;
+};
+
+// Summary of a single phase
+struct Summary {
+    double min;
+    double median;
+    double p99;
+    double mean;
+};
+
+// Loads puzzles from file in dotted string or delimited format (one per line) or packed binary format
+// Limit less than 1 loads all puzzles
+static bool loadFile(const QString &fileName, int limit, PuzzleSet &set) {
+    set.name = QFileInfo(fileName).fileName();
+
+    if (PuzzleFile::isPuzzleFile(fileName)) {
+        PuzzleFile file;
+        if (!file.open(fileName)) {
+            return false;
+        }
+
+        for (qint64 i = 0; i < file.count() && (limit < 1 || i < limit); ++i) {
+            set.puzzles.append(file.puzzle(i).toGrid());
+        }
+        return true;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream in(&file);
+    QString line;
+    while (in.readLineInto(&line) && (limit < 1 || set.puzzles.size() < limit)) {
+        Grid sudoku = GridFormat::fromString(line.trimmed());
+        if (!sudoku.isEmpty()) {
+            set.puzzles.append(sudoku);
+        }
+    }
+    return true;
+}
+
+static PuzzleSet testSet(const QString &name, const QList<Tests::Test> &tests) {
+    PuzzleSet set;
+    set.name = name;
+    for (auto &test : tests) {
+        set.puzzles.append(GridFormat::fromString(test.input));
+    }
+    return set;
+}
+
+// Solves all puzzles of set repeatedly with a single reused solver, after an untimed warm-up pass
+// (warm-up builds link templates, which are shared between solves afterwards)
+// Engine falls back to DLX if it does not support grid size of set (taken from first puzzle)
+static Samples runSet(const PuzzleSet &set, int repeat, Solver::Engine engine, bool propagation) {
+    Samples samples;
+    QScopedPointer<Solver> solver(Solver::create(engine, set.puzzles.isEmpty() ? 0 : set.puzzles.first().size()));
+    solver->setPropagation(propagation);
+
+    for (auto &sudoku : set.puzzles) {
+        solver->reset(sudoku);
+        solver->solve();
+    }
+
+    for (int r = 0; r < repeat; ++r) {
+        for (auto &sudoku : set.puzzles) {
+            solver->reset(sudoku);
+            if (solver->solve() && r == 0) {
+                ++samples.solved;
+            }
+
+            const Solver::PhaseTimes &times = solver->phaseTimes();
+            samples.propagate.append(times.propagate / 1000.0);
+            samples.build.append(times.build / 1000.0);
+            samples.cover.append(times.cover / 1000.0);
+            samples.search.append(times.search / 1000.0);
+            samples.total.append((times.propagate + times.build + times.cover + times.search) / 1000.0);
+        }
+    }
+
+    return samples;
+}
+
+static Summary summarize(QVector<double> values) {
+    Summary summary = {0.0, 0.0, 0.0, 0.0};
+    if (values.isEmpty()) {
+        return summary;
+    }
+
+    std::sort(values.begin(), values.end());
+    summary.min = values.first();
+    summary.median = values.at(values.size() / 2);
+    summary.p99 = values.at(qMin(values.size() - 1, static_cast<int>(values.size() * 0.99)));
+    for (auto &value : values) {
+        summary.mean += value;
+    }
+    summary.mean /= values.size();
+    return summary;
+}
+
+static double puzzlesPerSecond(const Samples &samples) {
+    double sum = 0.0;
+    for (auto &value : samples.total) {
+        sum += value;
+    }
+    return sum > 0.0 ? samples.total.size() / (sum / 1e6) : 0.0;
+}
+
+static void writeCsv(QTextStream &out, const QList<PuzzleSet> &sets, const QList<Samples> &results, int repeat) {
+    out << "set,puzzles,repeat,solved,phase,min_us,median_us,p99_us,mean_us,puzzles_per_second\n";
+    for (int i = 0; i < sets.size(); ++i) {
+        const Samples &samples = results.at(i);
+        QList<QPair<QString, const QVector<double> *>> phases = {
+            {"propagate", &samples.propagate}, {"build", &samples.build}, {"cover", &samples.cover},
+            {"search", &samples.search}, {"total", &samples.total}
+        };
+
+        for (auto &phase : phases) {
+            Summary summary = summarize(*phase.second);
+            out << sets.at(i).name << ',' << sets.at(i).puzzles.size() << ',' << repeat << ',' << samples.solved << ','
+                << phase.first << ',' << summary.min << ',' << summary.median << ',' << summary.p99 << ',' << summary.mean << ',';
+            if (phase.first == "total") {
+                out << puzzlesPerSecond(samples);
+            }
+            out << '\n';
+        }
+    }
+}
+
+static void writeJson(QTextStream &out, const QList<PuzzleSet> &sets, const QList<Samples> &results, int repeat) {
+    QJsonArray setsJson;
+    for (int i = 0; i < sets.size(); ++i) {
+        const Samples &samples = results.at(i);
+        QList<QPair<QString, const QVector<double> *>> phases = {
+            {"propagate", &samples.propagate}, {"build", &samples.build}, {"cover", &samples.cover},
+            {"search", &samples.search}, {"total", &samples.total}
+        };
+
+        QJsonObject phasesJson;
+        for (auto &phase : phases) {
+            Summary summary = summarize(*phase.second);
+            phasesJson[phase.first] = QJsonObject{
+                {"minUs", summary.min}, {"medianUs", summary.median}, {"p99Us", summary.p99}, {"meanUs", summary.mean}
+            };
+        }
+
+        setsJson.append(QJsonObject{
+            {"name", sets.at(i).name},
+            {"puzzles", sets.at(i).puzzles.size()},
+            {"repeat", repeat},
+            {"solved", samples.solved},
+            {"puzzlesPerSecond", puzzlesPerSecond(samples)},
+            {"phases", phasesJson}
+        });
+    }
+
+    out << QJsonDocument(QJsonObject{{"sets", setsJson}}).toJson();
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SudokuDLXBenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Sudoku DLX benchmark with per-phase timing (propagate, build, cover, search).\n"
+                                     "Runs in-code test cases (9x9 and 16x16) and optional puzzle files\n"
+                                     "(dotted string format or packed binary format).");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Additional puzzle files.", "[files...]");
+    QCommandLineOption repeatOption({"r", "repeat"}, "Number of timed passes over each set (default: 10).", "count", "10");
+    QCommandLineOption limitOption({"n", "limit"}, "Maximum number of puzzles loaded per file (default: all).", "count", "0");
+    QCommandLineOption formatOption({"f", "format"}, "Output format: csv or json (default: csv).", "format", "csv");
+    QCommandLineOption outputOption({"o", "output"}, "Output file (default: standard output).", "file");
+    QCommandLineOption noTestsOption("no-tests", "Skip in-code test cases.");
+    QCommandLineOption propagateOption("propagate", "Run constraint propagation pre-pass (naked and hidden singles) before search.");
+    QCommandLineOption engineOption({"e", "engine"}, "Solving engine: dlx or bitboard (9x9 only, DLX used for other sizes) (default: dlx).", "engine", "dlx");
+    parser.addOption(repeatOption);
+    parser.addOption(limitOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.addOption(noTestsOption);
+    parser.addOption(engineOption);
+    parser.addOption(propagateOption);
+    parser.process(app);
+
+    int repeat = qMax(1, parser.value(repeatOption).toInt());
+    int limit = parser.value(limitOption).toInt();
+    QString format = parser.value(formatOption);
+    if (format != "csv" && format != "json") {
+        qCritical() << "Unknown format" << format;
+        return 1;
+    }
+
+    Solver::Engine engine;
+    if (parser.value(engineOption) == Solver::engineName(Solver::Bitboard)) {
+        engine = Solver::Bitboard;
+    } else if (parser.value(engineOption) == Solver::engineName(Solver::DancingLinks)) {
+        engine = Solver::DancingLinks;
+    } else {
+        qCritical() << "Unknown engine" << parser.value(engineOption);
+        return 1;
+    }
+
+    // Sets
+    QList<PuzzleSet> sets;
+    if (!parser.isSet(noTestsOption)) {
+        sets.append(testSet("s9x9", Tests::s9x9));
+        sets.append(testSet("s16x16", Tests::s16x16));
+    }
+
+    for (auto &fileName : parser.positionalArguments()) {
+        PuzzleSet set;
+        if (!loadFile(fileName, limit, set)) {
+            qCritical() << "Failed to open" << fileName;
+            return 1;
+        }
+        sets.append(set);
+    }
+
+    // Run
+    QList<Samples> results;
+    for (auto &set : sets) {
+        results.append(runSet(set, repeat, engine, parser.isSet(propagateOption)));
+    }
+
+    // Report
+    QFile outFile;
+    bool opened;
+    if (parser.isSet(outputOption)) {
+        outFile.setFileName(parser.value(outputOption));
+        opened = outFile.open(QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        opened = outFile.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+
+    if (!opened) {
+        qCritical() << "Failed to open output";
+        return 1;
+    }
+
+    QTextStream out(&outFile);
+    if (format == "json") {
+        writeJson(out, sets, results, repeat);
+    } else {
+        writeCsv(out, sets, results, repeat);
+    }
+
+    return 0;
+}
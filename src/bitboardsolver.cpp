@@ -0,0 +1,462 @@
+#include "bitboardsolver.h"
+#include "puzzlefile.h"
+
+#include <QtAlgorithms>
+
+#include <chrono>
+
+namespace {
+    const quint32 RowCells = (1 << BitboardSolver::Size) - 1; // First row of band
+    const quint32 BandCells = (1 << 3 * BitboardSolver::Size) - 1;
+    const quint32 ColumnCells = 1 | 1 << BitboardSolver::Size | 1 << 2 * BitboardSolver::Size; // First column of band
+
+    // Search nodes between checks of control and time budget
+    const quint64 PollInterval = 4096;
+
+    // Lookup tables of a band of one value, indexed by row segments (9 bits: one per column) or by rows and regions
+    // (9 bits: bit 3 * r + j set for row r and region j)
+    struct BandTables {
+        quint8 regions[1 << BitboardSolver::Size]; // Regions holding a cell of row segment (bit j for region j)
+        // Rows and regions used by any placement of one cell per row and region within given rows and regions
+        // (0 if there is none)
+        quint16 fitting[1 << BitboardSolver::Size];
+        quint32 cells[1 << BitboardSolver::Size]; // Cells of rows and regions
+        quint32 peers[3 * BitboardSolver::Size]; // Other cells in row or region of cell
+
+        BandTables() {
+            for (int i = 0; i < (1 << BitboardSolver::Size); ++i) {
+                regions[i] = static_cast<quint8>((i & 7 ? 1 : 0) | (i & 7 << 3 ? 2 : 0) | (i & 7 << 6 ? 4 : 0));
+
+                cells[i] = 0;
+                for (int k = 0; k < BitboardSolver::Size; ++k) {
+                    if (i & 1 << k) {
+                        cells[i] |= 7u << (k / 3 * BitboardSolver::Size + k % 3 * 3);
+                    }
+                }
+
+                // Placements are permutations of regions over rows
+                int placements[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+                fitting[i] = 0;
+                for (auto &placement : placements) {
+                    int used = 1 << placement[0] | 1 << (3 + placement[1]) | 1 << (6 + placement[2]);
+                    if ((i & used) == used) {
+                        fitting[i] |= static_cast<quint16>(used);
+                    }
+                }
+            }
+
+            for (int k = 0; k < 3 * BitboardSolver::Size; ++k) {
+                int row = k / BitboardSolver::Size;
+                int region = k % BitboardSolver::Size / 3;
+                int regionRows = (1 | 1 << 3 | 1 << 6) << region;
+                peers[k] = (RowCells << row * BitboardSolver::Size | cells[regionRows]) & ~(1u << k);
+            }
+        }
+    };
+
+    const BandTables tables;
+}
+
+BitboardSolver::BitboardSolver()
+    : valid(true), levels(Cells + 1), dirty(0), outcome(NoSolution), control(nullptr), visited(0), nextPoll(PollInterval) {
+    for (int i = 0; i < Cells; ++i) {
+        cells[i] = -1;
+    }
+}
+
+BitboardSolver::BitboardSolver(Grid sudoku) : BitboardSolver() {
+    reset(sudoku);
+}
+
+void BitboardSolver::reset(Grid sudoku) {
+    valid = sudoku.size() == Size;
+    for (int i = 0; valid && i < Size; ++i) {
+        valid = sudoku.at(i).size() == Size;
+        for (int j = 0; valid && j < Size; ++j) {
+            cells[i * Size + j] = sudoku.at(i).at(j);
+        }
+    }
+    outcome = NoSolution;
+}
+
+void BitboardSolver::reset(const PuzzleView &puzzle) {
+    valid = puzzle.size() == Size;
+    if (valid) {
+        puzzle.unpack(cells);
+    }
+    outcome = NoSolution;
+}
+
+bool BitboardSolver::solve() {
+    times = PhaseTimes();
+    outcome = NoSolution;
+    visited = 0;
+    nextPoll = budget.nodes != 0 ? qMin(PollInterval, budget.nodes + 1) : PollInterval;
+    if (budget.milliseconds != 0) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget.milliseconds);
+    }
+    if (control != nullptr) {
+        control->nodes.store(0, std::memory_order_relaxed);
+    }
+    if (!valid) {
+        return false;
+    }
+
+    auto coverStart = std::chrono::steady_clock::now();
+    bool placed = placeGivens();
+    auto searchStart = std::chrono::steady_clock::now();
+    times.cover = std::chrono::duration_cast<std::chrono::nanoseconds>(searchStart - coverStart).count();
+    if (!placed) {
+        return false;
+    }
+
+    bool solved = search();
+    times.search = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - searchStart).count();
+    if (control != nullptr) {
+        control->nodes.store(visited, std::memory_order_relaxed);
+    }
+    if (solved) {
+        outcome = Solved;
+    }
+    return solved;
+}
+
+Grid BitboardSolver::solution() const {
+    Grid grid;
+    grid.reserve(Size);
+    for (int i = 0; i < Size; ++i) {
+        GridRow row;
+        row.reserve(Size);
+        for (int j = 0; j < Size; ++j) {
+            row.append(cells[i * Size + j]);
+        }
+        grid.append(row);
+    }
+
+    // Map filled cells (every cell holds its value once solved)
+    if (outcome == Solved) {
+        for (int i = 0; i < Cells; ++i) {
+            grid[i / Size][i % Size] = values[i];
+        }
+    }
+
+    return grid;
+}
+
+Solver::Result BitboardSolver::result() const {
+    return outcome;
+}
+
+quint64 BitboardSolver::nodesVisited() const {
+    return visited;
+}
+
+const Solver::PhaseTimes &BitboardSolver::phaseTimes() const {
+    return times;
+}
+
+void BitboardSolver::setControl(Control *control) {
+    this->control = control;
+}
+
+void BitboardSolver::setBudget(const Budget &budget) {
+    this->budget = budget;
+}
+
+bool BitboardSolver::placeGivens() {
+    State &root = levels[0];
+    for (int b = 0; b < Bands; ++b) {
+        for (int v = 0; v < Size; ++v) {
+            root.bands[v][b] = BandCells;
+        }
+        root.unsolved[b] = BandCells;
+    }
+    dirty = 0;
+
+    for (int i = 0; i < Cells; ++i) {
+        int value = cells[i];
+        if (value < 1) {
+            continue;
+        }
+
+        // Value not representable in grid or duplicate in row, column or region
+        int band = i / (3 * Size);
+        quint32 cell = 1u << i % (3 * Size);
+        if (value > Size || !(root.bands[value - 1][band] & cell)) {
+            return false;
+        }
+        place(root, value - 1, band, cell);
+    }
+
+    return true;
+}
+
+bool BitboardSolver::search() {
+    // Iterative backtracking, levels[level + 1] holds the state after placing a candidate of the cell branched on at level
+    int level = 0;
+    if ((++visited == nextPoll && poll()) || !propagate(levels[0])) {
+        return false;
+    }
+
+    while (true) {
+        State &state = levels[level];
+
+        // Exit if solution found (value of each cell is the only one still holding it)
+        if ((state.unsolved[0] | state.unsolved[1] | state.unsolved[2]) == 0) {
+            for (int v = 0; v < Size; ++v) {
+                for (int b = 0; b < Bands; ++b) {
+                    for (quint32 cells = state.bands[v][b]; cells != 0; cells &= cells - 1) {
+                        values[b * 3 * Size + qCountTrailingZeroBits(cells)] = static_cast<quint8>(v + 1);
+                    }
+                }
+            }
+            return true;
+        }
+
+        chooseCell(state);
+
+        // Place lowest remaining candidate into a copy of the state, backtrack while the current level has no more
+        // candidates to try, search next depth once propagation does not end in a contradiction
+        while (true) {
+            while (levels[level].remaining == 0) {
+                if (level == 0) {
+                    return false;
+                }
+                --level;
+            }
+
+            // Exit if cancelled (checked periodically)
+            if (++visited == nextPoll && poll()) {
+                return false;
+            }
+
+            State &parent = levels[level];
+            quint16 bit = parent.remaining & static_cast<quint16>(-parent.remaining);
+            parent.remaining ^= bit;
+            State &child = levels[level + 1];
+            child = parent;
+            dirty = 0;
+            if (place(child, qCountTrailingZeroBits(bit), parent.band, parent.cell) && propagate(child)) {
+                ++level;
+                break;
+            }
+        }
+    }
+}
+
+bool BitboardSolver::poll() {
+    if (control != nullptr) {
+        control->nodes.store(visited, std::memory_order_relaxed);
+    }
+
+    // Node budget allows exactly budget.nodes nodes, next check is scheduled no later than the one past it
+    nextPoll = visited + PollInterval;
+    if (budget.nodes != 0) {
+        if (visited > budget.nodes) {
+            --visited; // Node past budget is not searched
+            outcome = BudgetExhausted;
+            return true;
+        }
+        nextPoll = qMin(nextPoll, budget.nodes + 1);
+    }
+
+    if (control != nullptr && control->cancel.load(std::memory_order_relaxed)) {
+        outcome = Cancelled;
+        return true;
+    }
+    if (budget.milliseconds != 0 && std::chrono::steady_clock::now() >= deadline) {
+        outcome = BudgetExhausted;
+        return true;
+    }
+    return false;
+}
+
+bool BitboardSolver::place(State &state, int value, int band, quint32 cells) {
+    // Exit if placed cells share a row or region
+    quint32 peers = 0;
+    for (quint32 rest = cells; rest != 0; rest &= rest - 1) {
+        peers |= tables.peers[qCountTrailingZeroBits(rest)];
+    }
+    if (peers & cells) {
+        return false;
+    }
+    state.unsolved[band] &= ~cells;
+
+    // Other values lose cells, value loses other cells of their rows and regions
+    for (int v = 0; v < Size; ++v) {
+        quint32 candidates = state.bands[v][band];
+        quint32 left = candidates & ~(v == value ? peers : cells);
+        state.bands[v][band] = left;
+        dirty |= static_cast<quint32>(left != candidates) << (3 * v + band);
+    }
+
+    // Value loses cells of their columns in other bands (columns of band folded into first row, then spread to all)
+    quint32 columns = ((cells | cells >> Size | cells >> 2 * Size) & RowCells) * ColumnCells;
+    for (int b = 0; b < Bands; ++b) {
+        quint32 candidates = state.bands[value][b];
+        quint32 left = b == band ? candidates : candidates & ~columns;
+        state.bands[value][b] = left;
+        dirty |= static_cast<quint32>(left != candidates) << (3 * value + b);
+    }
+    return true;
+}
+
+bool BitboardSolver::propagate(State &state) {
+    while (true) {
+        while (dirty != 0) {
+            int band = qCountTrailingZeroBits(dirty);
+            dirty &= dirty - 1;
+            if (!updateBand(state, band / 3, band % 3)) {
+                return false;
+            }
+        }
+
+        // Singles are looked for only once bands settle (cheapest first)
+        if (!placeNakedSingles(state)) {
+            return false;
+        }
+        if (dirty == 0 && !placeColumnSingles(state)) {
+            return false;
+        }
+        if (dirty == 0) {
+            return true;
+        }
+    }
+}
+
+bool BitboardSolver::updateBand(State &state, int value, int band) {
+    quint32 cells = state.bands[value][band];
+    int regions = tables.regions[cells & RowCells] | tables.regions[cells >> Size & RowCells] << 3
+            | tables.regions[cells >> 2 * Size] << 6;
+    cells &= tables.cells[tables.fitting[regions]];
+    if (cells == 0) {
+        return false;
+    }
+    state.bands[value][band] = cells;
+
+    // Place cells left alone in their row (every row keeps at least one)
+    quint32 singles = 0;
+    for (int r = 0; r < 3; ++r) {
+        quint32 row = cells & RowCells << r * Size;
+        if (!(row & (row - 1))) {
+            singles |= row;
+        }
+    }
+    singles &= state.unsolved[band];
+    return singles == 0 || place(state, value, band, singles);
+}
+
+bool BitboardSolver::placeNakedSingles(State &state) {
+    for (int b = 0; b < Bands; ++b) {
+        // Cells holding at least one and at least two values
+        quint32 once = 0;
+        quint32 twice = 0;
+        for (int v = 0; v < Size; ++v) {
+            twice |= once & state.bands[v][b];
+            once |= state.bands[v][b];
+        }
+        if (state.unsolved[b] & ~once) {
+            return false;
+        }
+
+        // Place singles of each value at once
+        quint32 singles = state.unsolved[b] & ~twice;
+        for (int v = 0; v < Size && singles != 0; ++v) {
+            quint32 cells = singles & state.bands[v][b];
+            if (cells != 0 && !place(state, v, b, cells)) {
+                return false;
+            }
+            singles &= ~cells;
+        }
+    }
+    return true;
+}
+
+bool BitboardSolver::placeColumnSingles(State &state) {
+    for (int v = 0; v < Size; ++v) {
+        // Columns holding at least one and at least two cells of value
+        quint32 once = 0;
+        quint32 twice = 0;
+        for (int b = 0; b < Bands; ++b) {
+            for (int r = 0; r < 3; ++r) {
+                quint32 row = state.bands[v][b] >> r * Size & RowCells;
+                twice |= once & row;
+                once |= row;
+            }
+        }
+        if (once != RowCells) {
+            return false;
+        }
+
+        // Place cells of columns with single cell, band by band
+        quint32 columns = (~twice & RowCells) * ColumnCells;
+        for (int b = 0; b < Bands; ++b) {
+            quint32 cells = state.bands[v][b] & columns & state.unsolved[b];
+            if (cells != 0 && !place(state, v, b, cells)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void BitboardSolver::chooseCell(State &state) const {
+    // Empty cells with two candidates (cells holding at least one, two and three values)
+    quint32 pairs[Bands];
+    for (int b = 0; b < Bands; ++b) {
+        quint32 once = 0;
+        quint32 twice = 0;
+        quint32 thrice = 0;
+        for (int v = 0; v < Size; ++v) {
+            thrice |= twice & state.bands[v][b];
+            twice |= once & state.bands[v][b];
+            once |= state.bands[v][b];
+        }
+        pairs[b] = state.unsolved[b] & twice & ~thrice;
+    }
+
+    // Take the one with most empty peers (its placement removes most candidates)
+    state.cell = 0;
+    int bestPeers = -1;
+    for (int b = 0; b < Bands; ++b) {
+        for (quint32 rest = pairs[b]; rest != 0; rest &= rest - 1) {
+            int k = qCountTrailingZeroBits(rest);
+            int peers = 0;
+            for (int other = 0; other < Bands; ++other) {
+                quint32 cells = other == b ? tables.peers[k] : ColumnCells << k % Size;
+                peers += qPopulationCount(cells & state.unsolved[other]);
+            }
+            if (peers > bestPeers) {
+                bestPeers = peers;
+                state.band = b;
+                state.cell = 1u << k;
+            }
+        }
+    }
+
+    // Otherwise count values of every empty cell
+    if (state.cell == 0) {
+        int bestCount = Size + 1;
+        for (int b = 0; b < Bands; ++b) {
+            for (quint32 unsolved = state.unsolved[b]; unsolved != 0; unsolved &= unsolved - 1) {
+                quint32 cell = unsolved & (~unsolved + 1);
+                int count = 0;
+                for (int v = 0; v < Size; ++v) {
+                    count += (state.bands[v][b] & cell) != 0;
+                }
+                if (count < bestCount) {
+                    bestCount = count;
+                    state.band = b;
+                    state.cell = cell;
+                }
+            }
+        }
+    }
+
+    state.remaining = 0;
+    for (int v = 0; v < Size; ++v) {
+        if (state.bands[v][state.band] & state.cell) {
+            state.remaining |= static_cast<quint16>(1 << v);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "solver.h"
+
+#include <QVector>
+
+#include <chrono>
+
+// Bitboard solving engine specialized for 9x9 grids
+// Each value holds a 27-bit mask of its candidate cells per band (three rows of regions), updated only where a placement
+// changed it: band update keeps rows and regions that fit one placement of the value per row and region (which places
+// hidden singles of rows and regions), naked singles and hidden singles of columns are placed once bands settle
+// Search copies this state to the next level and branches on an empty cell with least candidates
+class BitboardSolver : public Solver {
+public:
+    static const int Size = 9;
+    static const int Cells = Size * Size;
+    static const int Bands = 3;
+
+    BitboardSolver();
+    explicit BitboardSolver(Grid sudoku);
+
+    void reset(Grid sudoku) override;
+    void reset(const PuzzleView &puzzle) override;
+
+    bool solve() override;
+    Grid solution() const override;
+    Result result() const override;
+    quint64 nodesVisited() const override;
+    const PhaseTimes &phaseTimes() const override;
+    void setControl(Control *control) override;
+    void setBudget(const Budget &budget) override;
+
+private:
+    // Search state after placements of all levels above, copied to the next level before branching
+    struct State {
+        // Candidate cells of value per band (bit 9 * r + c for row r of band and column c), placed cells stay set
+        quint32 bands[Size][Bands];
+        quint32 unsolved[Bands]; // Empty cells per band
+        int band; // Band of cell branched on
+        quint32 cell; // Cell branched on (bit in its band)
+        quint16 remaining; // Candidates of branched cell not yet tried (bit i - 1 set if value i)
+    };
+
+    int cells[Cells]; // Values already present in the grid (row-major, less than 1 if empty)
+    bool valid; // Grid is 9x9
+
+    QVector<State> levels; // Search stack (every level fills at least one cell)
+    quint32 dirty; // Bands changed since their last update (bit 3 * value index + band)
+    quint8 values[Cells]; // Values of solution (row-major, valid once solved)
+
+    PhaseTimes times;
+    Result outcome;
+    Control *control; // Cancel request and progress (optional)
+    Budget budget;
+    quint64 visited; // Search nodes visited in last solve
+    quint64 nextPoll; // Value of visited at which search checks control and budget next
+    std::chrono::steady_clock::time_point deadline; // End of time budget of current search
+
+    // Places values already present in the grid into root state, returns false if values are conflicting
+    bool placeGivens();
+    // Runs iterative backtracking search
+    bool search();
+
+    // Publishes progress and checks cancel request and budget, returns true if search should stop (sets outcome)
+    // Schedules next check
+    bool poll();
+
+    // Places value (index of bit) in cells of band, removes it from candidates of their peers and other values from them
+    // Marks changed bands dirty, returns false if cells share a row or region
+    bool place(State &state, int value, int band, quint32 cells);
+    // Updates dirty bands and places singles until none is left, returns false on contradiction
+    // (value without fitting rows and regions in a band or without cells in a column, cell without candidates)
+    bool propagate(State &state);
+    // Narrows candidates of value in band to rows and regions that fit, places cells left alone in their row
+    // Returns false if none fit
+    bool updateBand(State &state, int value, int band);
+    // Places empty cells with a single candidate, returns false if a cell has none
+    bool placeNakedSingles(State &state);
+    // Places values with a single cell in a column, returns false if a column has none for a value
+    bool placeColumnSingles(State &state);
+    // Chooses cell to branch on, an empty one with two candidates and most empty peers if there is one,
+    // otherwise an empty one with least candidates
+    void chooseCell(State &state) const;
+};
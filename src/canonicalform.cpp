@@ -0,0 +1,326 @@
+#include "canonicalform.h"
+#include "gridformat.h"
+
+#include <QPair>
+
+#include <algorithm>
+#include <functional>
+
+const int CanonicalForm::MaxCandidates = 512;
+
+namespace {
+    // Signature of a line (row or column), sorted keys of its values
+    using Signature = QVector<int>;
+    // Index ranges [first, second) of equal signatures in a sorted order
+    using Ties = QVector<QPair<int, int>>;
+
+    // Line orders consistent with line signatures, before permuting ties
+    // Bands (or stacks) are ordered by sorted signatures of their lines, lines within each band by own signature
+    struct LineOrdering {
+        QVector<int> bands; // Bands in order
+        Ties bandTies;
+        QVector<QVector<int>> lines; // Lines of each band in order (indexed by band)
+        QVector<Ties> lineTies;
+        quint64 count; // Number of orders with all ties permuted (saturates above limit)
+    };
+
+    // Sorts indices stably by keys and finds ranges of equal keys
+    template <typename Key> void sortWithTies(QVector<int> &indices, const QVector<Key> &keys, Ties &ties) {
+        std::stable_sort(indices.begin(), indices.end(), [&keys](int a, int b) {
+            return keys.at(a) < keys.at(b);
+        });
+
+        ties.clear();
+        for (int begin = 0, end = 1; end <= indices.size(); ++end) {
+            if (end == indices.size() || keys.at(indices.at(begin)) != keys.at(indices.at(end))) {
+                if (end - begin > 1) {
+                    ties.append({begin, end});
+                }
+                begin = end;
+            }
+        }
+    }
+
+    // Multiplies count by number of permutations of ties, saturating once above limit
+    void countPermutations(quint64 &count, const Ties &ties, quint64 limit) {
+        for (auto &tie : ties) {
+            for (int k = 2; k <= tie.second - tie.first && count <= limit; ++k) {
+                count *= k;
+            }
+        }
+    }
+
+    LineOrdering orderLines(const QVector<Signature> &signatures, int sizeSqrt, quint64 limit) {
+        LineOrdering ordering;
+        ordering.count = 1;
+
+        QVector<QVector<Signature>> bandKeys(sizeSqrt);
+        ordering.lines.resize(sizeSqrt);
+        ordering.lineTies.resize(sizeSqrt);
+        for (int band = 0; band < sizeSqrt; ++band) {
+            QVector<int> &lines = ordering.lines[band];
+            for (int i = 0; i < sizeSqrt; ++i) {
+                lines.append(band * sizeSqrt + i);
+            }
+            sortWithTies(lines, signatures, ordering.lineTies[band]);
+            countPermutations(ordering.count, ordering.lineTies.at(band), limit);
+
+            for (int line : lines) {
+                bandKeys[band].append(signatures.at(line));
+            }
+            ordering.bands.append(band);
+        }
+
+        sortWithTies(ordering.bands, bandKeys, ordering.bandTies);
+        countPermutations(ordering.count, ordering.bandTies, limit);
+        return ordering;
+    }
+
+    // All arrangements of items with each tie permuted independently (only the given one if not permuting)
+    QList<QVector<int>> permuteTies(QVector<int> items, const Ties &ties, bool permute) {
+        QList<QVector<int>> arrangements;
+        std::function<void(int)> next = [&](int t) {
+            if (!permute || t == ties.size()) {
+                arrangements.append(items);
+                return;
+            }
+
+            // Iterators are taken anew, as appended arrangements share items
+            int first = ties.at(t).first;
+            int last = ties.at(t).second;
+            std::sort(items.begin() + first, items.begin() + last);
+            do {
+                next(t + 1);
+            } while (std::next_permutation(items.begin() + first, items.begin() + last));
+        };
+        next(0);
+        return arrangements;
+    }
+
+    // All line orders of ordering (only the first one if not permuting ties)
+    QList<QVector<int>> lineOrders(const LineOrdering &ordering, bool permute) {
+        int bandCount = ordering.bands.size();
+        QVector<QList<QVector<int>>> bandLines(bandCount);
+        for (int band = 0; band < bandCount; ++band) {
+            bandLines[band] = permuteTies(ordering.lines.at(band), ordering.lineTies.at(band), permute);
+        }
+
+        QList<QVector<int>> orders;
+        for (auto &bands : permuteTies(ordering.bands, ordering.bandTies, permute)) {
+            // Cartesian product of line arrangements of bands in this band order
+            QVector<int> order;
+            std::function<void(int)> next = [&](int i) {
+                if (i == bandCount) {
+                    orders.append(order);
+                    return;
+                }
+                for (auto &lines : bandLines.at(bands.at(i))) {
+                    int mark = order.size();
+                    order += lines;
+                    next(i + 1);
+                    order.resize(mark);
+                }
+            };
+            next(0);
+        }
+        return orders;
+    }
+
+    Grid toGrid(const QVector<int> &cells, int size) {
+        Grid sudoku;
+        sudoku.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            GridRow row;
+            row.reserve(size);
+            for (int j = 0; j < size; ++j) {
+                row.append(cells.at(i * size + j));
+            }
+            sudoku.append(row);
+        }
+        return sudoku;
+    }
+}
+
+CanonicalForm::CanonicalForm(const Grid &sudoku) : size(sudoku.size()), transposed(false) {
+    // Exit if not supported NxN size or values out of range
+    if (!GridFormat::isValidSize(size)) {
+        size = 0;
+        return;
+    }
+    QVector<int> values;
+    values.reserve(size * size);
+    for (auto &row : sudoku) {
+        if (row.size() != size) {
+            size = 0;
+            return;
+        }
+        for (int value : row) {
+            if (value > size) {
+                size = 0;
+                return;
+            }
+            values.append(qMax(0, value));
+        }
+    }
+
+    int sizeSqrt = 1;
+    while (sizeSqrt * sizeSqrt < size) {
+        ++sizeSqrt;
+    }
+
+    // Signatures of both orientations, keys combine how often the value occurs in the grid
+    // with the number of values in the crossing line (both independent of labels and line order)
+    QVector<int> digitCount(size + 1, 0);
+    QVector<int> rowValues(size, 0);
+    QVector<int> columnValues(size, 0);
+    for (int i = 0; i < size * size; ++i) {
+        if (values.at(i) != 0) {
+            ++digitCount[values.at(i)];
+            ++rowValues[i / size];
+            ++columnValues[i % size];
+        }
+    }
+
+    QVector<Signature> rowSignatures(size);
+    QVector<Signature> columnSignatures(size);
+    for (int i = 0; i < size * size; ++i) {
+        int value = values.at(i);
+        if (value != 0) {
+            rowSignatures[i / size].append(digitCount.at(value) * (size + 1) + columnValues.at(i % size));
+            columnSignatures[i % size].append(digitCount.at(value) * (size + 1) + rowValues.at(i / size));
+        }
+    }
+    for (int i = 0; i < size; ++i) {
+        std::sort(rowSignatures[i].begin(), rowSignatures[i].end());
+        std::sort(columnSignatures[i].begin(), columnSignatures[i].end());
+    }
+
+    // Transposition swaps roles of rows and columns
+    LineOrdering rows = orderLines(rowSignatures, sizeSqrt, MaxCandidates);
+    LineOrdering columns = orderLines(columnSignatures, sizeSqrt, MaxCandidates);
+    bool permute = rows.count * columns.count * 2 <= static_cast<quint64>(MaxCandidates);
+    QList<QVector<int>> rowOrders = lineOrders(rows, permute);
+    QList<QVector<int>> columnOrders = lineOrders(columns, permute);
+
+    // Lexicographically smallest candidate, digits relabeled in order of first appearance
+    QVector<int> candidate(size * size);
+    QVector<int> labels(size + 1);
+    for (int orientation = 0; orientation < 2; ++orientation) {
+        bool transpose = orientation == 1;
+        const QList<QVector<int>> &firstOrders = transpose ? columnOrders : rowOrders;
+        const QList<QVector<int>> &secondOrders = transpose ? rowOrders : columnOrders;
+
+        for (auto &first : firstOrders) {
+            for (auto &second : secondOrders) {
+                labels.fill(0);
+                int next = 1;
+                bool smaller = cells.isEmpty();
+                bool larger = false;
+
+                for (int i = 0; i < size && !larger; ++i) {
+                    for (int j = 0; j < size; ++j) {
+                        int value = transpose ? values.at(second.at(j) * size + first.at(i))
+                                              : values.at(first.at(i) * size + second.at(j));
+                        if (value != 0) {
+                            if (labels.at(value) == 0) {
+                                labels[value] = next++;
+                            }
+                            value = labels.at(value);
+                        }
+
+                        // Compare until first difference
+                        int k = i * size + j;
+                        if (!smaller) {
+                            if (value > cells.at(k)) {
+                                larger = true;
+                                break;
+                            }
+                            smaller = value < cells.at(k);
+                        }
+                        candidate[k] = value;
+                    }
+                }
+
+                if (smaller) {
+                    cells = candidate;
+                    transposed = transpose;
+                    rowOrder = first;
+                    columnOrder = second;
+                    label = labels;
+                    // Digits not in grid get remaining labels in original order
+                    for (int value = 1; value <= size; ++value) {
+                        if (label.at(value) == 0) {
+                            label[value] = next++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    digit.fill(0, size + 1);
+    for (int value = 1; value <= size; ++value) {
+        digit[label.at(value)] = value;
+    }
+}
+
+bool CanonicalForm::isValid() const {
+    return size != 0;
+}
+
+Grid CanonicalForm::grid() const {
+    return toGrid(cells, size);
+}
+
+QByteArray CanonicalForm::key() const {
+    return pack(grid());
+}
+
+Grid CanonicalForm::toCanonical(const Grid &sudoku) const {
+    QVector<int> mapped(size * size);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int value = transposed ? sudoku.at(columnOrder.at(j)).at(rowOrder.at(i))
+                                   : sudoku.at(rowOrder.at(i)).at(columnOrder.at(j));
+            mapped[i * size + j] = value >= 1 && value <= size ? label.at(value) : 0;
+        }
+    }
+    return toGrid(mapped, size);
+}
+
+Grid CanonicalForm::toOriginal(const Grid &sudoku) const {
+    QVector<int> mapped(size * size);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            int value = sudoku.at(i).at(j);
+            int cell = transposed ? columnOrder.at(j) * size + rowOrder.at(i) : rowOrder.at(i) * size + columnOrder.at(j);
+            mapped[cell] = value >= 1 && value <= size ? digit.at(value) : 0;
+        }
+    }
+    return toGrid(mapped, size);
+}
+
+QByteArray CanonicalForm::pack(const Grid &sudoku) {
+    QByteArray packed;
+    packed.reserve(1 + sudoku.size() * sudoku.size());
+    packed.append(static_cast<char>(sudoku.size()));
+    for (auto &row : sudoku) {
+        for (int value : row) {
+            packed.append(static_cast<char>(qMax(0, value)));
+        }
+    }
+    return packed;
+}
+
+Grid CanonicalForm::unpack(const QByteArray &packed) {
+    int size = packed.isEmpty() ? 0 : static_cast<uchar>(packed.at(0));
+    if (packed.size() != 1 + size * size) {
+        return Grid();
+    }
+
+    QVector<int> cells(size * size);
+    for (int i = 0; i < size * size; ++i) {
+        cells[i] = static_cast<uchar>(packed.at(1 + i));
+    }
+    return toGrid(cells, size);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+#include "solver.h"
+
+// Canonical form of a grid under Sudoku symmetries: digit relabeling, transposition, band and stack permutations,
+// and row and column permutations within bands and stacks
+// Transformed variants of a puzzle share the canonical grid, grids are mapped between both layouts through the transform
+// Lines are ordered by signatures that do not depend on digit labels or line order, ties are resolved by trying all
+// their permutations (lexicographically smallest canonical grid wins), as long as there are at most MaxCandidates
+// Beyond that ties keep input order, so variants of highly symmetric grids may get different canonical grids
+class CanonicalForm {
+public:
+    static const int MaxCandidates; // Maximum line orders tried over both orientations
+
+    // Canonicalizes grid, invalid if grid is not a supported NxN size or holds values above N
+    explicit CanonicalForm(const Grid &sudoku);
+
+    bool isValid() const;
+    // Canonical grid, digits relabeled in order of first appearance (row-major), empty cells are 0
+    Grid grid() const;
+    // Compact key of canonical grid - Reference pack()
+    QByteArray key() const;
+
+    // Maps grid of the same size (e.g. solution) from original to canonical layout and digits
+    Grid toCanonical(const Grid &sudoku) const;
+    // Maps grid of the same size (e.g. solution of canonical grid) from canonical to original layout and digits
+    Grid toOriginal(const Grid &sudoku) const;
+
+    // Packs grid into size followed by one byte per cell (row-major, 0 if empty), values must be at most 255
+    static QByteArray pack(const Grid &sudoku);
+    // Reverse of pack, empty grid if malformed
+    static Grid unpack(const QByteArray &packed);
+
+private:
+    int size;
+    bool transposed; // Original grid is transposed before reordering lines
+    QVector<int> rowOrder; // Row of (transposed) original grid at each canonical row
+    QVector<int> columnOrder; // Column of (transposed) original grid at each canonical column
+    QVector<int> label; // Canonical digit of original digit (index 0 unused)
+    QVector<int> digit; // Original digit of canonical digit (index 0 unused)
+    QVector<int> cells; // Canonical grid (row-major, 0 if empty)
+};
@@ -0,0 +1,107 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+
+#include <QDebug>
+
+#include "dlx.h"
+#include "gridformat.h"
+#include "puzzlefile.h"
+
+// Converts packed binary puzzle file to dotted string format (one per line, delimited format for sizes above 49x49)
+static bool binaryToDotted(const QString &inName, const QString &outName) {
+    PuzzleFile in;
+    if (!in.open(inName)) {
+        qCritical() << "Failed to open" << inName;
+        return false;
+    }
+
+    QFile outFile(outName);
+    if (!outFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCritical() << "Failed to open" << outName;
+        return false;
+    }
+
+    QTextStream out(&outFile);
+    for (qint64 i = 0; i < in.count(); ++i) {
+        out << GridFormat::toString(in.puzzle(i).toGrid()) << '\n';
+    }
+
+    qInfo() << "Converted" << in.count() << "puzzles to dotted string format";
+    return true;
+}
+
+// Converts dotted string or delimited format (one per line) to packed binary puzzle file
+// All puzzles must be of the same size (taken from first puzzle), invalid lines are skipped
+static bool dottedToBinary(const QString &inName, const QString &outName) {
+    QFile inFile(inName);
+    if (!inFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qCritical() << "Failed to open" << inName;
+        return false;
+    }
+
+    PuzzleWriter out;
+    bool opened = false;
+    qint64 skipped = 0;
+
+    QTextStream in(&inFile);
+    QString line;
+    while (in.readLineInto(&line)) {
+        line = line.trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        Grid sudoku = GridFormat::fromString(line);
+        if (sudoku.isEmpty()) {
+            ++skipped;
+            continue;
+        }
+
+        // Size taken from first valid puzzle
+        if (!opened) {
+            if (!out.open(outName, sudoku.size())) {
+                qCritical() << "Failed to open" << outName;
+                return false;
+            }
+            opened = true;
+        }
+
+        if (!out.write(sudoku)) {
+            ++skipped;
+        }
+    }
+    out.close();
+
+    qInfo() << "Converted" << out.count() << "puzzles to packed binary format, skipped" << skipped;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SudokuDLXConvert");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts between dotted string format (53.2..4..., delimited 5,3,.,2,... above 49x49)\n"
+                                     "and packed binary puzzle files.\n"
+                                     "Direction is detected from input file contents.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("input", "Input file.");
+    parser.addPositionalArgument("output", "Output file.");
+    parser.process(app);
+
+    QStringList args = parser.positionalArguments();
+    if (args.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    bool converted;
+    if (PuzzleFile::isPuzzleFile(args.at(0))) {
+        converted = binaryToDotted(args.at(0), args.at(1));
+    } else {
+        converted = dottedToBinary(args.at(0), args.at(1));
+    }
+
+    return converted ? 0 : 1;
+}
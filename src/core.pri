@@ -0,0 +1,32 @@
+# Solver core shared by all targets (no widgets dependency)
+
+CONFIG += c++11
+
+# Search statistics (ExactCover::stats(), DLX::stats()), zero cost when disabled
+dlx_stats: DEFINES += DLX_STATS
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/bitboardsolver.cpp \
+    $$PWD/canonicalform.cpp \
+    $$PWD/dlx.cpp \
+    $$PWD/exactcover.cpp \
+    $$PWD/generator.cpp \
+    $$PWD/gridformat.cpp \
+    $$PWD/livegrid.cpp \
+    $$PWD/puzzlefile.cpp \
+    $$PWD/solutioncache.cpp \
+    $$PWD/solver.cpp
+
+HEADERS += \
+    $$PWD/bitboardsolver.h \
+    $$PWD/canonicalform.h \
+    $$PWD/dlx.h \
+    $$PWD/exactcover.h \
+    $$PWD/generator.h \
+    $$PWD/gridformat.h \
+    $$PWD/livegrid.h \
+    $$PWD/puzzlefile.h \
+    $$PWD/solutioncache.h \
+    $$PWD/solver.h
@@ -1,326 +1,574 @@
 #include "dlx.h"
+#include "puzzlefile.h"
+#include "solutioncache.h"
 
-#include <cmath>
-
-const int DLX::MaxSearchDepth = 1000;
+#include <QMutex>
+#include <QtAlgorithms>
 
-DLX::DLX(Grid sudoku) : sudoku(sudoku) {
-    // Frequently used size variations - Reference DLX::buildSparseMatrix()
-    size = sudoku.size();
-    sizeSq = size * size;
-    sizeSqrt = static_cast<int>(sqrt(size));
-    rows = sizeSq * size;
-    columns = 4 * sizeSq;
+#include <atomic>
+#include <chrono>
+#include <cmath>
 
-    // Initialize
-    nodesToClean.reserve(columns * (size + 1)); // 9x9 => 324 * (9 + 1)
-    solutions.reserve(MaxSearchDepth); // Maximum
-    origValues.reserve(sizeSq); // Maximum: 9x9 => 81
+namespace {
+    // Integer square root of a perfect square (compile-time)
+    constexpr int intSqrt(int n, int root = 1) {
+        return root * root >= n ? root : intSqrt(n, root + 1);
+    }
 
-    matrix.reserve(rows);
-    for (int i = 0; i < rows; ++i) {
-        SparseRow row = SparseRow();
-        row.reserve(columns);
-        for (int j = 0; j < columns; ++j) {
-            row.append(false);
+    // Size constants, compile-time for specialized sizes (N > 0), runtime values otherwise
+    template <int N> struct SizeConstants {
+        static constexpr int size(int runtime) { return N > 0 ? N : runtime; }
+        static constexpr int sizeSqrt(int runtime) { return N > 0 ? intSqrt(N) : runtime; }
+    };
+
+    // Prebuilt exact cover problem of empty grid of one size, entries form a list that only grows at its head
+    // and are kept for the lifetime of the process (never changed once published)
+    struct TemplateEntry {
+        int size;
+        QSharedPointer<const ExactCover> exactCover;
+        const TemplateEntry *next;
+    };
+
+    const TemplateEntry *findTemplate(const TemplateEntry *entry, int size) {
+        while (entry != nullptr && entry->size != size) {
+            entry = entry->next;
         }
-        matrix.append(row);
+        return entry;
     }
 }
 
-DLX::~DLX() {
-    for (auto &node : nodesToClean) {
-        delete node;
+DLX::DLX(Grid sudoku) : propagation(false), propagated(false), finished(false), searched(false), outcome(NoSolution),
+                         cache(nullptr), cached(false), size(-1) {
+    reset(sudoku);
+}
+
+void DLX::reset(Grid sudoku) {
+    resize(sudoku.size());
+
+    // Flatten (row-major)
+    int *cell = cells.data();
+    for (auto &row : sudoku) {
+        for (auto &value : row) {
+            *cell++ = value;
+        }
     }
+}
 
-    delete head;
+void DLX::reset(const PuzzleView &puzzle) {
+    resize(puzzle.size());
+    puzzle.unpack(cells.data());
 }
 
 bool DLX::solve() {
-    buildSparseMatrix();
-    buildLinkedList();
-    coverGridValues();
-    return search();
-}
+    if (cache == nullptr) {
+        return solveUncached();
+    }
 
-Grid DLX::solution() {
-    mapSolutionToGrid();
-    return sudoku;
+    // Exit if answered from cache (maps back to this grid)
+    CanonicalForm form(toGrid(cells));
+    if (cache->find(form, outcome, cachedSolution)) {
+        times = PhaseTimes();
+        searched = false;
+        cached = true;
+        return outcome == Solved;
+    }
+
+    bool solved = solveUncached();
+    cache->insert(form, outcome, solved ? solution() : Grid());
+    return solved;
 }
 
-// DLX
-void DLX::coverColumn(Node *column) {
-    // Remove column
-    column->left->right = column->right;
-    column->right->left = column->left;
+bool DLX::solveUncached() {
+    outcome = NoSolution;
+    if (!prepare()) {
+        return false;
+    }
 
-    // Remove all rows in the column from other columns they are in
-    for (Node *node = column->down; node != column; node = node->down) {
-        for (Node *tmp = node->right; tmp != node; tmp = tmp->right) {
-            tmp->up->down = tmp->down;
-            tmp->down->up = tmp->up;
-            --tmp->head->size;
-        }
+    // Completed by propagation alone
+    if (finished) {
+        outcome = Solved;
+        return true;
     }
+
+    searched = true;
+    auto searchStart = std::chrono::steady_clock::now();
+    bool solved = exactCover.solve();
+    times.search = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - searchStart).count();
+    outcome = solved ? Solved : unsolvedResult();
+    return solved;
 }
 
-void DLX::uncoverColumn(Node *column) {
-    // Take advantage of the fact that every node that has been removed retains information about its neighbors
+quint64 DLX::countSolutions(quint64 limit) {
+    outcome = NoSolution;
+    if (!prepare()) {
+        return 0;
+    }
 
-    // Re-add all rows in the column from other columns they were in
-    for (Node *node = column->up; node != column; node = node->up) {
-        for (Node *tmp = node->left; tmp != node; tmp = tmp->left) {
-            ++tmp->head->size;
-            tmp->up->down = tmp;
-            tmp->down->up = tmp;
-        }
+    // Completed by propagation alone (forced values, single solution)
+    if (finished) {
+        outcome = Solved;
+        return 1;
     }
 
-    // Re-add column
-    column->left->right = column;
-    column->right->left = column;
+    searched = true;
+    quint64 count = exactCover.countSolutions(limit);
+    outcome = exactCover.interruption() != ExactCover::NotInterrupted ? unsolvedResult() : (count > 0 ? Solved : NoSolution);
+    return count;
 }
 
-bool DLX::search(int depth) {
-    // Exit if solution found
-    if (head->right == head) {
-        return true;
+bool DLX::hasUniqueSolution() {
+    return countSolutions(2) == 1 && outcome == Solved;
+}
+
+quint64 DLX::enumerateSolutions(const std::function<bool(const SolutionView &)> &callback) {
+    // View needs rows of all values, including the ones placed by propagation
+    if (!prepare(true)) {
+        return 0;
     }
 
-    // Cover next column (with least number of nodes or the right one)
-    Node *column = chooseNextColumn();
-    coverColumn(column);
+    searched = true;
+    return exactCover.enumerateSolutions([this, &callback](const ExactCover::SolutionView &rows) {
+        return callback(SolutionView(rows, size));
+    });
+}
 
-    for (Node *row = column->down; row != column; row = row->down) {
-        solutions.append(row);
+DLX::Result DLX::result() const {
+    return outcome;
+}
 
-        // Cover to the right
-        for (Node *right = row->right; right != row; right = right->right) {
-            coverColumn(right->head);
-        }
+quint64 DLX::nodesVisited() const {
+    return searched ? exactCover.nodesVisited() : 0;
+}
 
-        // Search next depth (recursion) and exit if solved
-        if (search(depth + 1)) {
-            return true;
-        }
+const DLX::PhaseTimes &DLX::phaseTimes() const {
+    return times;
+}
 
-        // Remove last solution (backtrack)
-        solutions.removeOne(row);
-        column = row->head;
+void DLX::setPropagation(bool enabled) {
+    propagation = enabled;
+}
 
-        // Uncover to the left (backtrack)
-        for (Node *left = row->left; left != row; left = left->left) {
-            uncoverColumn(left->head);
-        }
+void DLX::setControl(Control *control) {
+    exactCover.setCancel(control ? &control->cancel : nullptr);
+    exactCover.setProgress(control ? &control->nodes : nullptr);
+}
+
+void DLX::setBudget(const Budget &budget) {
+    exactCover.setBudget(budget.nodes, budget.milliseconds);
+}
+
+void DLX::setCache(SolutionCache *cache) {
+    this->cache = cache;
+}
+
+bool DLX::fromCache() const {
+    return cached;
+}
+
+void DLX::setHeuristic(const Heuristic &heuristic) {
+    exactCover.setHeuristic(heuristic);
+}
+
+const DLX::SearchStats &DLX::stats() const {
+    return exactCover.stats();
+}
+
+Grid DLX::solution() const {
+    if (cached) {
+        return cachedSolution;
     }
 
-    // Uncover last column (backtrack)
-    uncoverColumn(column);
+    // Start from original values (or values after propagation), keeping them for further solves
+    Grid grid = toGrid(propagated ? reduced : cells);
 
-    // Not yet solved
-    return false;
+    // Nothing searched if completed by propagation alone
+    if (!finished) {
+        mapSolutionToGrid(grid);
+    }
+    return grid;
 }
 
-// Exact Cover Builder
-void DLX::buildSparseMatrix() {
-    int counter = 0;
-    int j = 0;
-    int x = 0;
+// Parallel
+bool DLX::solveParallel(int threads) {
+    bool solved = countSolutionsParallel(1, threads) > 0;
+    outcome = solved ? Solved : (searched ? unsolvedResult() : NoSolution);
+    return solved;
+}
 
-    // Sparse Matrix:
-    // Columns: Constraints of the puzzle (4 per number)
-    // - Each number has its own set of constraints => size ^ 2 * 4 columns (9x9 => 324 columns)
-    // Rows: Every position for every number => size ^ 3 rows (9x9 = 729 rows)
-    // - Each row represents only one candidate position => 4 1s in a row, representing constraints of that position
+quint64 DLX::countSolutionsParallel(quint64 limit, int threads) {
+    if (!prepare()) {
+        return 0;
+    }
 
-    // Constraint 1: Position - Only one number in single cell
-    for (int i = 0; i < matrix.size(); ++i) {
-        matrix[i][j] = true;
+    // Completed by propagation alone (forced values, single solution)
+    if (finished) {
+        return 1;
+    }
 
-        if (++counter >= sudoku.size()) {
-            ++j;
-            counter = 0;
-        }
+    searched = true;
+    return exactCover.countSolutionsParallel(limit, threads);
+}
+
+bool DLX::solvePortfolio(int threads) {
+    outcome = NoSolution;
+    if (!prepare()) {
+        return false;
     }
 
-    // Constraint 2: Row - Only one instance of a number in single row
-    counter = 1;
-    for (j = sizeSq; j < 2 * sizeSq; ++j) {
-        for (int i = x; i < counter * sizeSq; i += size) {
-            matrix[i][j] = true;
+    // Completed by propagation alone
+    if (finished) {
+        outcome = Solved;
+        return true;
+    }
+
+    searched = true;
+    auto searchStart = std::chrono::steady_clock::now();
+    bool solved = exactCover.solvePortfolio(threads);
+    times.search = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - searchStart).count();
+    outcome = solved ? Solved : unsolvedResult();
+    return solved;
+}
+
+// Solution View
+DLX::SolutionView::SolutionView(const ExactCover::SolutionView &rows, int gridSize) : rows(rows), gridSize(gridSize) {}
+
+int DLX::SolutionView::size() const {
+    return rows.size();
+}
+
+int DLX::SolutionView::rowId(int i) const {
+    return rows.rowId(i);
+}
+
+int DLX::SolutionView::candidate(int i) const {
+    return rowId(i) % gridSize + 1;
+}
+
+int DLX::SolutionView::row(int i) const {
+    return rowId(i) / (gridSize * gridSize);
+}
+
+int DLX::SolutionView::column(int i) const {
+    return rowId(i) / gridSize % gridSize;
+}
+
+// Propagation
+template <int N> int DLX::propagateSingles() {
+    const int size = SizeConstants<N>::size(this->size);
+    const int sizeSqrt = SizeConstants<N>::sizeSqrt(this->sizeSqrt);
+    const int sizeSq = size * size;
+
+    // Used value masks of rows, columns and regions (units), bit value - 1 set if value used
+    // Cells of unit u are (u < size: row, u < 2 * size: column, otherwise region) - Reference unitCell below
+    // Fixed-size storage for specialized sizes
+    const quint64 all = size == 64 ? ~quint64(0) : (quint64(1) << size) - 1;
+    quint64 fixedUsed[N > 0 ? 3 * N : 1] = {};
+    QVector<quint64> runtimeUsed(N > 0 ? 0 : 3 * size, 0);
+    quint64 *used = N > 0 ? fixedUsed : runtimeUsed.data();
+    int *values = reduced.data();
+
+    auto unitCell = [=](int unit, int k) {
+        int index = unit % size;
+        if (unit < size) {
+            return index * size + k;
+        } else if (unit < 2 * size) {
+            return k * size + index;
+        }
+        return ((index / sizeSqrt) * sizeSqrt + k / sizeSqrt) * size + (index % sizeSqrt) * sizeSqrt + k % sizeSqrt;
+    };
+    auto regionOf = [=](int cell) {
+        return (cell / size / sizeSqrt) * sizeSqrt + cell % size / sizeSqrt;
+    };
+    auto candidates = [&](int cell) {
+        return ~(used[cell / size] | used[size + cell % size] | used[2 * size + regionOf(cell)]) & all;
+    };
+    auto place = [&](int cell, quint64 bit) {
+        used[cell / size] |= bit;
+        used[size + cell % size] |= bit;
+        used[2 * size + regionOf(cell)] |= bit;
+        values[cell] = qCountTrailingZeroBits(bit) + 1;
+    };
+
+    // Values already present in the grid
+    int empty = 0;
+    for (int cell = 0; cell < sizeSq; ++cell) {
+        int value = values[cell];
+        if (value < 1) {
+            ++empty;
+            continue;
         }
 
-        if ((j + 1) % size == 0) {
-            x = counter * sizeSq;
-            ++counter;
-        } else {
-            ++x;
+        // Value not representable in grid or duplicate in row, column or region
+        if (value > size) {
+            return -1;
+        }
+        quint64 bit = quint64(1) << (value - 1);
+        if (!(candidates(cell) & bit)) {
+            return -1;
         }
+        place(cell, bit);
     }
 
-    // Constraint 3: Column - Only one instance of a number in single column
-    j = 2 * sizeSq;
-    for (int i = 0; i < rows; ++i) {
-        matrix[i][j] = true;
+    bool changed = true;
+    while (changed && empty > 0) {
+        changed = false;
 
-        if (++j >= 3 * sizeSq) {
-            j = 2 * sizeSq;
-        }
-    }
+        // Naked singles (cell with a single candidate)
+        for (int cell = 0; cell < sizeSq; ++cell) {
+            if (values[cell] > 0) {
+                continue;
+            }
 
-    // Constraint 4: Region - Only one instance of a number in single region (at 9x9, region is 3x3)
-    x = 0;
-    for (j = 3 * sizeSq; j < columns; ++j) {
-        for (int l = 0; l < sizeSqrt; ++l) {
-            for (int k = 0; k < sizeSqrt; ++k) {
-                matrix[x + l * size + k * sizeSq][j] = true;
+            quint64 mask = candidates(cell);
+            if (mask == 0) {
+                return -1;
+            }
+            if (qPopulationCount(mask) == 1) {
+                place(cell, mask);
+                --empty;
+                changed = true;
             }
         }
 
-        int tmp = j + 1 - 3 * sizeSq;
-        if (tmp % (sizeSqrt * size) == 0) {
-            x += (sizeSqrt - 1) * sizeSq + (sizeSqrt - 1) * size + 1;
-        } else if (tmp % size == 0) {
-            x += size * (sizeSqrt - 1) + 1;
-        } else {
-            ++x;
+        // Hidden singles (value with a single place in unit)
+        for (int unit = 0; unit < 3 * size; ++unit) {
+            quint64 once = 0;
+            quint64 twice = 0;
+            for (int k = 0; k < size; ++k) {
+                int cell = unitCell(unit, k);
+                if (values[cell] < 1) {
+                    quint64 mask = candidates(cell);
+                    twice |= once & mask;
+                    once |= mask;
+                }
+            }
+
+            quint64 needed = ~used[unit] & all;
+            if (needed & ~once) {
+                return -1;
+            }
+
+            // Place one at a time, as placing may take the only place of another value (conflict)
+            for (quint64 singles = needed & once & ~twice; singles; singles &= singles - 1) {
+                quint64 bit = singles & (~singles + 1);
+                int k = 0;
+                while (k < size && (values[unitCell(unit, k)] > 0 || !(candidates(unitCell(unit, k)) & bit))) {
+                    ++k;
+                }
+                if (k == size) {
+                    return -1;
+                }
+                place(unitCell(unit, k), bit);
+                --empty;
+                changed = true;
+            }
         }
     }
+
+    return empty;
 }
 
-void DLX::buildLinkedList() {
-    // Create head
-    head = new Node;
-    head->up = head;
-    head->down = head;
-    head->left = head;
-    head->right = head;
-    head->size = -1;
-    head->head = head;
-
-    // Create all column nodes
-    Node *right = head;
-    for (int i = 0; i < columns; ++i, right = right->right) {
-        Node *node = new Node;
-        nodesToClean.append(node);
-        node->size = 0;
-
-        // Link to all sides
-        node->up = node;
-        node->down = node;
-        node->left = right;
-        node->right = head;
-        node->head = node;
-        right->right = node;
+// Exact Cover Builder
+void DLX::resize(int gridSize) {
+    if (gridSize == size) {
+        return;
     }
 
-    GridRow id = {0, 1, 1};
+    // Frequently used size variations - Reference DLX::rowColumns()
+    size = gridSize;
+    sizeSq = size * size;
+    sizeSqrt = static_cast<int>(sqrt(size));
+    cells.resize(sizeSq);
+    reduced.resize(sizeSq);
+
+    switch (size) {
+    case 4:
+        propagateSinglesForSize = &DLX::propagateSingles<4>;
+        break;
+    case 9:
+        propagateSinglesForSize = &DLX::propagateSingles<9>;
+        break;
+    case 16:
+        propagateSinglesForSize = &DLX::propagateSingles<16>;
+        break;
+    case 25:
+        propagateSinglesForSize = &DLX::propagateSingles<25>;
+        break;
+    default:
+        propagateSinglesForSize = &DLX::propagateSingles<0>;
+        break;
+    }
+}
 
-    // Add a node for each 'true' present in sparse matrix and update column nodes accordingly
-    for (int i = 0; i < rows; ++i) {
-        // Update row identification
-        if (i != 0 && i % sizeSq == 0) {
-            id[0] -= size - 1;
-            ++id[1];
-            id[2] -= size - 1;
-        } else if (i != 0 && i % size == 0) {
-            id[0] -= size - 1;
-            ++id[2];
-        } else {
-            ++id[0];
+bool DLX::prepare(bool requireLinks) {
+    times = PhaseTimes();
+    searched = false;
+    cached = false;
+
+    propagated = propagation;
+    finished = false;
+    if (propagated) {
+        auto propagateStart = std::chrono::steady_clock::now();
+        std::copy(cells.constBegin(), cells.constEnd(), reduced.begin());
+        int empty = (this->*propagateSinglesForSize)();
+        times.propagate = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - propagateStart).count();
+
+        if (empty < 0) {
+            return false;
         }
 
-        // Update column nodes according to sparse matrix value
-        Node *top = head->right;
-        Node *prev = nullptr;
-        for (int j = 0; j < columns; ++j, top = top->right) {
-            // Add node for each 'true' sparse matrix value
-            if (matrix.at(i).at(j)) {
-                Node *node = new Node;
-                nodesToClean.append(node);
-                node->row = id;
-
-                // First node in row
-                if (prev == nullptr) {
-                    prev = node;
-                    prev->right = node;
-                }
+        // Skip building links (solution is mapped from reduced values)
+        if (empty == 0 && !requireLinks) {
+            finished = true;
+            return true;
+        }
+    }
 
-                // Link to all sides
-                node->left = prev;
-                node->right = prev->right;
-                node->right->left = node;
-                prev->right = node;
-                node->head = top;
-                node->down = top;
-                node->up = top->up;
-
-                top->up->down = node;
-                ++top->size;
-                top->up = node;
-
-                // Insert into column
-                if (top->down == top) {
-                    top->down = node;
-                }
-                prev = node;
-            }
+    // Copy prebuilt links of empty grid (single bulk copy, in place if size unchanged)
+    auto buildStart = std::chrono::steady_clock::now();
+    exactCover = *exactCoverTemplate(size);
+    auto coverStart = std::chrono::steady_clock::now();
+    bool covered = coverGridValues(propagated ? reduced : cells);
+    auto coverEnd = std::chrono::steady_clock::now();
+
+    times.build = std::chrono::duration_cast<std::chrono::nanoseconds>(coverStart - buildStart).count();
+    times.cover = std::chrono::duration_cast<std::chrono::nanoseconds>(coverEnd - coverStart).count();
+    return covered;
+}
+
+QSharedPointer<const ExactCover> DLX::exactCoverTemplate(int size) {
+    static std::atomic<const TemplateEntry *> templates(nullptr);
+    static QMutex mutex;
+
+    // Exit if already built (lookup without locking, only building takes the lock)
+    const TemplateEntry *entry = findTemplate(templates.load(std::memory_order_acquire), size);
+    if (entry != nullptr) {
+        return entry->exactCover;
+    }
+
+    // Build unless another thread built it while waiting for the lock
+    QMutexLocker locker(&mutex);
+    entry = findTemplate(templates.load(std::memory_order_acquire), size);
+    if (entry == nullptr) {
+        QSharedPointer<const ExactCover> exactCover;
+        switch (size) {
+        case 4:
+            exactCover = buildExactCover<4>(size);
+            break;
+        case 9:
+            exactCover = buildExactCover<9>(size);
+            break;
+        case 16:
+            exactCover = buildExactCover<16>(size);
+            break;
+        case 25:
+            exactCover = buildExactCover<25>(size);
+            break;
+        default:
+            exactCover = buildExactCover<0>(size);
+            break;
         }
+        entry = new TemplateEntry{size, exactCover, templates.load(std::memory_order_relaxed)};
+        templates.store(entry, std::memory_order_release);
     }
+    return entry->exactCover;
 }
 
-void DLX::coverGridValues() {
-    for (int i = 0; i < size; ++i) {
-        for (int j = 0; j < size; ++j) {
-            // Cover column of value already present in the grid
-            if (sudoku.at(i).at(j) > 0) {
-                Node *column = nullptr;
-                Node *tmp = nullptr;
-
-                bool exit = false;
-                for (column = head->right; column != head; column = column->right) {
-                    for (tmp = column->down; tmp != column; tmp = tmp->down) {
-                        if (tmp->row.at(0) == sudoku.at(i).at(j)
-                                && tmp->row.at(1) - 1 == i
-                                && tmp->row.at(2) - 1 == j) {
-                            exit = true;
-                            break;
-                        }
-                    }
-                    if (exit) break;
-                }
+template <int N> void DLX::rowColumns(int runtimeSize, int id, int *cols) {
+    const int size = SizeConstants<N>::size(runtimeSize);
+    const int sizeSqrt = SizeConstants<N>::sizeSqrt(static_cast<int>(std::sqrt(runtimeSize)));
+    const int sizeSq = size * size;
+
+    // Exact Cover Matrix:
+    // Columns: Constraints of the puzzle (4 per number)
+    // - Each number has its own set of constraints => size ^ 2 * 4 columns (9x9 => 324 columns)
+    // Rows: Every position for every number => size ^ 3 rows (9x9 = 729 rows)
+    // - Each row represents only one candidate position => 4 1s in a row, representing constraints of that position
+    // The 4 column indices of each row are derived directly from row identification
+    int candidate = id % size;
+    int row = id / sizeSq;
+    int col = id / size % size;
+    int region = (row / sizeSqrt) * sizeSqrt + col / sizeSqrt;
+
+    // Constraint 1: Position - Only one number in single cell
+    cols[0] = row * size + col;
+    // Constraint 2: Row - Only one instance of a number in single row
+    cols[1] = sizeSq + row * size + candidate;
+    // Constraint 3: Column - Only one instance of a number in single column
+    cols[2] = 2 * sizeSq + col * size + candidate;
+    // Constraint 4: Region - Only one instance of a number in single region (at 9x9, region is 3x3)
+    cols[3] = 3 * sizeSq + region * size + candidate;
+}
 
-                coverColumn(column);
-                origValues.append(tmp);
+template <int N> QSharedPointer<const ExactCover> DLX::buildExactCover(int runtimeSize) {
+    const int size = SizeConstants<N>::size(runtimeSize);
+    const int columns = 4 * size * size; // 9x9 => 324
+    const int rows = size * size * size; // 9x9 => 729
+
+    // Add all possibilities in packed row identification order
+    QSharedPointer<ExactCover> exactCover(new ExactCover(columns));
+    exactCover->reserve(rows, 4 * rows);
+    int cols[4];
+    for (int i = 0; i < rows; ++i) {
+        rowColumns<N>(size, i, cols);
+        exactCover->addRow(cols, 4);
+    }
+    exactCover->build();
+    return exactCover;
+}
 
-                for (Node *node = tmp->right; node != tmp; node = node->right) {
-                    coverColumn(node->head);
+bool DLX::coverGridValues(const QVector<int> &values) {
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            // Cover columns of value already present in the grid
+            int value = values.at(i * size + j);
+            if (value > 0) {
+                // Value not representable in grid or row already removed by another value (duplicate in row, column or region)
+                if (value > size || !exactCover.fixRow(packRow(value, i, j))) {
+                    return false;
                 }
             }
         }
     }
+
+    return true;
 }
 
 // Helpers
-DLX::Node *DLX::chooseNextColumn() {
-    Node *column = head->right;
-    for (Node *right = column->right; right != head; right = right->right) {
-        // Select if less values in current right column than in original right column
-        if (right->size < column->size) {
-            column = right;
+Grid DLX::toGrid(const QVector<int> &values) const {
+    Grid grid;
+    grid.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        GridRow row;
+        row.reserve(size);
+        for (int j = 0; j < size; ++j) {
+            row.append(values.at(i * size + j));
         }
+        grid.append(row);
     }
-    return column;
+    return grid;
 }
 
-void DLX::mapSolutionToGrid() {
-    // Map found solution values
-    for (int i = 0; i < solutions.size(); ++i) {
-        sudoku[solutions.at(i)->row.at(1) - 1][solutions.at(i)->row.at(2) - 1] = solutions.at(i)->row.at(0);
+DLX::Result DLX::unsolvedResult() const {
+    switch (exactCover.interruption()) {
+    case ExactCover::Cancelled:
+        return Cancelled;
+    case ExactCover::BudgetExhausted:
+        return BudgetExhausted;
+    case ExactCover::NotInterrupted:
+    default:
+        return NoSolution;
     }
+}
+
+int DLX::packRow(int candidate, int row, int col) const {
+    return (row * size + col) * size + candidate - 1;
+}
 
-    // Map original values untouched by solution
-    for (int i = 0; i < origValues.size(); ++i) {
-        sudoku[origValues.at(i)->row.at(1) - 1][origValues.at(i)->row.at(2) - 1] = origValues.at(i)->row.at(0);
+void DLX::mapSolutionToGrid(Grid &grid) const {
+    // Unpack row identification [candidate, row, column] and write value to grid
+    // Map original values and found solution values
+    for (int id : exactCover.solution()) {
+        grid[id / sizeSq][id / size % size] = id % size + 1;
     }
 }
@@ -1,76 +1,148 @@
 #pragma once
 
 #include <QObject>
+#include <QSharedPointer>
+#include <QVector>
 
-// Use QList::at() wherever possible, as it is guaranteed constant time (QList::operator[] is not)
+#include <functional>
 
-using GridRow = QList<int>;
-using Grid = QList<GridRow>;
+#include "exactcover.h"
+#include "solver.h"
 
-using SparseRow = QList<bool>;
-using SparseMatrix = QList<SparseRow>;
+class SolutionCache;
 
-class DLX {
+// Dancing links solving engine (any NxN size), Sudoku front-end of the exact cover solver
+class DLX : public Solver {
 public:
-    static const int MaxSearchDepth;
-
-    struct Node {
-        Node *head;
-
-        Node *up;
-        Node *down;
-        Node *left;
-        Node *right;
-
-        int size; // Column header
-        GridRow row = {0, 0, 0}; // Row identification for mapping solutions to sudoku grid [candidate, row, column]
+    // Lightweight read-only view of a found solution (givens and chosen rows), valid only during enumeration callback
+    // Row identification is packed as (row * size + column) * size + candidate - 1
+    class SolutionView {
+    public:
+        // Number of rows in solution (one per cell)
+        int size() const;
+        // Packed row identification of i-th row
+        int rowId(int i) const;
+        // Unpacked row identification of i-th row (candidate 1-based, row and column 0-based)
+        int candidate(int i) const;
+        int row(int i) const;
+        int column(int i) const;
+
+    private:
+        friend class DLX;
+        SolutionView(const ExactCover::SolutionView &rows, int gridSize);
+
+        const ExactCover::SolutionView &rows;
+        int gridSize;
     };
 
+    using SearchStats = ExactCover::SearchStats;
+    using Heuristic = ExactCover::Heuristic;
+
     DLX(Grid sudoku);
-    ~DLX();
 
-    bool solve();
-    Grid solution();
+    // Replaces the grid to solve, keeping link storage for reuse (in-place reset on next solve)
+    void reset(Grid sudoku) override;
+    void reset(const PuzzleView &puzzle) override;
+
+    bool solve() override;
+    Grid solution() const override;
+    Result result() const override;
+    quint64 nodesVisited() const override;
+    const PhaseTimes &phaseTimes() const override;
+    // Values forced by naked and hidden singles are placed before building links (skipped entirely if grid gets completed)
+    // Solution set is unchanged, but search may find a different first solution of grids with multiple solutions
+    void setPropagation(bool enabled) override;
+    // Cancel and progress are forwarded to the exact cover search (all search functions, including parallel)
+    void setControl(Control *control) override;
+    // Budget applies to each search (solve, count, enumeration), parallel search splits node budget between threads
+    void setBudget(const Budget &budget) override;
+    // Looks up solve() results in cache before searching (also transformed variants of cached grids) and stores
+    // definite results in it (nullptr to detach), must outlive the solves
+    // Cached solution of a grid with several solutions may differ from the one search would find first
+    void setCache(SolutionCache *cache);
+    // Last solve() was answered from cache (no search, phase times and visited nodes are zero)
+    bool fromCache() const;
+    // Branching heuristic of all searches (kept between grids) - Reference ExactCover::Heuristic
+    void setHeuristic(const Heuristic &heuristic);
+    // Search statistics of last solve (or accumulated over all solutions when counting or enumerating)
+    const SearchStats &stats() const;
+
+    // Counts solutions, stopping as soon as limit is reached (0 for no limit)
+    // Solutions are not mapped to grid while counting, solution() afterwards returns the last one found
+    // result() afterwards is Solved if any found, unless counting was interrupted (budget or cancel)
+    quint64 countSolutions(quint64 limit = 0);
+    // Checks if grid is a proper puzzle (exactly one solution, stops searching at second one)
+    // False if search was interrupted before deciding
+    bool hasUniqueSolution();
+    // Streams all solutions to callback without copying grids, callback returns false to stop the search
+    // Returns number of solutions passed to callback
+    quint64 enumerateSolutions(const std::function<bool(const SolutionView &)> &callback);
+
+    // Parallel search - Reference ExactCover::solveParallel()
+    bool solveParallel(int threads = 0);
+    quint64 countSolutionsParallel(quint64 limit = 0, int threads = 0);
+    // Portfolio search (differently randomized searches race) - Reference ExactCover::solvePortfolio()
+    bool solvePortfolio(int threads = 0);
+
+    // Returns shared prebuilt exact cover problem of empty grid of given size, building it on first use (thread-safe,
+    // built once per size, locks only while building)
+    // Rows are in packed row identification order, columns are cell, row, column and region constraints (size * size each)
+    static QSharedPointer<const ExactCover> exactCoverTemplate(int size);
 
 private:
-    Grid sudoku;
+    QVector<int> cells; // Values already present in the grid (row-major, less than 1 if empty)
+    QVector<int> reduced; // Values after propagation pre-pass (same layout as cells)
+    bool propagation; // Propagation pre-pass enabled
+    bool propagated; // Last prepare ran propagation pre-pass (links built from reduced values)
+    bool finished; // Last prepare completed the grid by propagation alone (links not built)
+    bool searched; // Last solve reached search (exact cover holds its statistics)
+    Result outcome; // Result of last solve
+    SolutionCache *cache;
+    bool cached; // Last solve answered from cache
+    Grid cachedSolution; // Solution of last solve if answered from cache
 
     // Size and variations
+    // Size-dependent passes are specialized for common sizes (4, 9, 16, 25) with compile-time constants
+    // and dispatched by size, other sizes use runtime values (N = 0)
     int size;
     int sizeSq;
     int sizeSqrt;
-    int rows;
-    int columns;
-
-    // Links
-    Node *head;
-    QList<Node *> nodesToClean;
-    QList<Node *> solutions;
-    QList<Node *> origValues;
-
-    // Matrix
-    SparseMatrix matrix;
-
-    // DLX
-    // Remove a column from the matrix
-    void coverColumn(Node *column);
-    // Reverse of cover
-    void uncoverColumn(Node *column);
-    // Runs DLX search
-    bool search(int depth = 0);
+
+    // Exact cover problem of the grid
+    // Rows are added in packed row identification order, so exact cover row id equals packed row identification
+    ExactCover exactCover;
+    PhaseTimes times;
+
+    // Propagation
+    // Applies naked and hidden singles to reduced values until nothing changes
+    // Returns number of empty cells left or -1 if values are conflicting (no solution)
+    template <int N> int propagateSingles();
+    int (DLX::*propagateSinglesForSize)();
 
     // Exact Cover Builder
-    // Builds initial matrix containing all possibilities
-    void buildSparseMatrix();
-    // Builds a toroidal doubly linked list out of the sparse matrix
-    void buildLinkedList();
-    // Covers columns of values that are already present in the grid
-    void coverGridValues();
+    // Runs propagation pre-pass (if enabled), loads links and covers values already present in the grid
+    // Links are not loaded if propagation completed the grid, unless building links is required (enumeration)
+    // Returns false if values are conflicting
+    bool prepare(bool requireLinks = false);
+    // Prepares storage for given grid size (kept if size unchanged)
+    void resize(int gridSize);
+    // Computes the 4 constraint column indices of a row (candidate position) without storing the matrix
+    template <int N> static void rowColumns(int size, int id, int *cols);
+    // Builds exact cover problem of empty grid (all possibilities)
+    template <int N> static QSharedPointer<const ExactCover> buildExactCover(int size);
+    // Covers columns of values that are already present in the grid (after propagation if it ran)
+    // Returns false if values are conflicting (no solution)
+    bool coverGridValues(const QVector<int> &values);
 
     // Helpers
-    // Chooses column with least number of nodes (deterministically) or the right one
-    // Choosing the column with the least number of nodes decreases the branching of the algorithm
-    Node *chooseNextColumn();
+    // Solves without looking up cache
+    bool solveUncached();
+    // Grid of given flattened values (row-major)
+    Grid toGrid(const QVector<int> &values) const;
+    // Result of exact cover search that did not find a solution
+    Result unsolvedResult() const;
+    // Packs row identification [candidate, row, column] into a single integer (equal to exact cover matrix row index)
+    int packRow(int candidate, int row, int col) const;
     // Maps found solution back to 2D grid
-    void mapSolutionToGrid();
+    void mapSolutionToGrid(Grid &grid) const;
 };
@@ -0,0 +1,1032 @@
+#include "exactcover.h"
+
+#include <QMutex>
+#include <QThread>
+
+#include <thread>
+
+// Search statistics are compiled in only when enabled (CONFIG += dlx_stats)
+#ifdef DLX_STATS
+#define DLX_STAT(statement) statement
+const bool ExactCover::StatsEnabled = true;
+#else
+#define DLX_STAT(statement)
+const bool ExactCover::StatsEnabled = false;
+#endif
+
+const int ExactCover::MaxSearchDepth = 4096; // Fits 64x64 Sudoku (one level per empty cell)
+const int ExactCover::MaxSplitDepth = 8;
+const int ExactCover::TasksPerThread = 16;
+const int ExactCover::PollInterval = 1024;
+const int ExactCover::BucketedColumns = 2000;
+const int ExactCover::RandomTieCandidates = 16;
+
+ExactCover::ExactCover(int primaryColumns, int secondaryColumns)
+    : rowStart({0}), built(false),
+      primary(primaryColumns), columns(primaryColumns + secondaryColumns), rows(0),
+      secondaryHead(columns + 1), nodeCount(0), bucketHeads(columns + 2), maxColumnSize(0), bucketLimit(0), minBucket(0),
+      givens(0), depth(0),
+      cancel(nullptr), stop(nullptr), progress(nullptr), visited(0), nextPoll(PollInterval),
+      nodeBudget(0), timeBudget(0), stopReason(NotInterrupted) {
+    attachLinks();
+}
+
+ExactCover::ExactCover(const ExactCover &other)
+    : rowStart(other.rowStart), rowColumns(other.rowColumns), built(other.built),
+      primary(other.primary), columns(other.columns), rows(other.rows),
+      secondaryHead(other.secondaryHead), nodeCount(other.nodeCount), links(other.links),
+      bucketHeads(other.bucketHeads), maxColumnSize(other.maxColumnSize), bucketLimit(other.bucketLimit), minBucket(other.minBucket),
+      choices(other.choices), givens(other.givens), depth(other.depth),
+      cancel(nullptr), stop(nullptr), progress(nullptr), visited(other.visited), nextPoll(other.nextPoll),
+      nodeBudget(0), timeBudget(0), stopReason(other.stopReason) {
+    attachLinks();
+}
+
+ExactCover &ExactCover::operator=(const ExactCover &other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    rowStart = other.rowStart;
+    rowColumns = other.rowColumns;
+    built = other.built;
+    primary = other.primary;
+    columns = other.columns;
+    rows = other.rows;
+    secondaryHead = other.secondaryHead;
+    nodeCount = other.nodeCount;
+    bucketHeads = other.bucketHeads;
+    maxColumnSize = other.maxColumnSize;
+    bucketLimit = other.bucketLimit;
+    minBucket = other.minBucket;
+
+    // Reset in place (no allocation) if of same shape, otherwise share and detach (single allocation and copy)
+    if (links.size() == other.links.size()) {
+        std::copy(other.links.constBegin(), other.links.constEnd(), links.begin());
+    } else {
+        links = other.links;
+    }
+    if (choices.size() == other.choices.size()) {
+        std::copy(other.choices.constBegin(), other.choices.constEnd(), choices.begin());
+    } else {
+        choices = other.choices;
+    }
+    attachLinks();
+
+    // Degree order stacks belong to search in progress of previous matrix, prepared again on next search
+    rowOrder.clear();
+    rowDegree.clear();
+    orderNext.clear();
+    orderEnd.clear();
+
+    givens = other.givens;
+    depth = other.depth;
+    visited = other.visited;
+    nextPoll = other.nextPoll;
+    stopReason = other.stopReason;
+    return *this;
+}
+
+// Builder
+int ExactCover::addRow(const int *columns, int count) {
+    Q_ASSERT(!built);
+
+    // Exit if empty (no node to link, so it could neither be fixed nor chosen)
+    if (count < 1) {
+        return -1;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        Q_ASSERT(columns[i] >= 0 && columns[i] < this->columns);
+        rowColumns.append(columns[i]);
+    }
+    rowStart.append(rowColumns.size());
+    return rows++;
+}
+
+int ExactCover::addRow(const QVector<int> &columns) {
+    return addRow(columns.constData(), columns.size());
+}
+
+void ExactCover::reserve(int rows, int entries) {
+    rowStart.reserve(rows + 1);
+    rowColumns.reserve(entries);
+}
+
+void ExactCover::build() {
+    if (built) {
+        return;
+    }
+
+    // Exact node count is known up-front: heads + column nodes + one node per column of each row
+    nodeCount = 2 + columns + rowColumns.size();
+
+    // Bucket count is known up-front from column sizes
+    bucketLimit = primary >= BucketedColumns ? primary : 0;
+    maxColumnSize = 0;
+    if (bucketLimit != 0) {
+        QVector<int> sizes(columns, 0);
+        for (int col : rowColumns) {
+            maxColumnSize = qMax(maxColumnSize, ++sizes[col]);
+        }
+    }
+
+    links.fill(0, 6 * nodeCount + columns + 2 + rows + 2 * (bucketHeads + maxColumnSize + 1));
+    attachLinks();
+
+    // Create heads (secondary columns are linked to their own head, so they are never chosen)
+    for (int node : {head, secondaryHead}) {
+        up[node] = node;
+        down[node] = node;
+        left[node] = node;
+        right[node] = node;
+        column[node] = node;
+        columnSize[node] = -1;
+    }
+
+    // Create all column nodes
+    for (int i = 0; i < columns; ++i) {
+        int node = 1 + i;
+        int list = i < primary ? head : secondaryHead;
+        columnSize[node] = 0;
+
+        // Link to all sides
+        up[node] = node;
+        down[node] = node;
+        left[node] = left[list];
+        right[node] = list;
+        column[node] = node;
+        right[left[list]] = node;
+        left[list] = node;
+    }
+
+    // Add a node for each column of each row and update column nodes accordingly
+    int node = secondaryHead + 1;
+    for (int i = 0; i < rows; ++i) {
+        int prev = -1;
+        rowNode[i] = node;
+        for (int j = rowStart.at(i); j < rowStart.at(i + 1); ++j, ++node) {
+            int top = 1 + rowColumns.at(j); // Column nodes follow head
+            rowId[node] = i;
+
+            // First node in row
+            if (prev == -1) {
+                prev = node;
+                right[prev] = node;
+            }
+
+            // Link to all sides
+            left[node] = prev;
+            right[node] = right[prev];
+            left[right[node]] = node;
+            right[prev] = node;
+            column[node] = top;
+            down[node] = top;
+            up[node] = up[top];
+
+            down[up[top]] = node;
+            ++columnSize[top];
+            up[top] = node;
+
+            prev = node;
+        }
+    }
+
+    // Fill size buckets (every list head points to itself when empty)
+    for (int bucket = bucketHeads; bucket <= bucketHeads + maxColumnSize; ++bucket) {
+        bucketNext[bucket] = bucket;
+        bucketPrev[bucket] = bucket;
+    }
+    for (int col = 1; col <= bucketLimit; ++col) {
+        bucketInsert(col, columnSize[col]);
+    }
+    minBucket = 0;
+
+    // Maximum: one row per column (each chosen row covers at least one column)
+    choices.fill(0, columns);
+    givens = 0;
+    depth = 0;
+
+    // Rows are in links now
+    rowStart.clear();
+    rowColumns.clear();
+    built = true;
+}
+
+int ExactCover::primaryColumns() const {
+    return primary;
+}
+
+int ExactCover::secondaryColumns() const {
+    return columns - primary;
+}
+
+int ExactCover::rowCount() const {
+    return rows;
+}
+
+bool ExactCover::fixRow(int row) {
+    build();
+    releaseSearch();
+    Q_ASSERT(row >= 0 && row < rows);
+
+    // Row is still present only if none of its columns have been covered
+    int node = rowNode[row];
+    int tmp = node;
+    do {
+        if (right[left[column[tmp]]] != column[tmp]) {
+            return false;
+        }
+        tmp = right[tmp];
+    } while (tmp != node);
+
+    selectRow(node);
+    choices[givens++] = node;
+    depth = givens;
+    return true;
+}
+
+bool ExactCover::unfixRow(int row) {
+    build();
+    releaseSearch();
+    Q_ASSERT(row >= 0 && row < rows);
+
+    // Exit if not fixed
+    int node = rowNode[row];
+    int index = givens - 1;
+    while (index >= 0 && choices.at(index) != node) {
+        --index;
+    }
+    if (index < 0) {
+        return false;
+    }
+
+    // Undo down to the row, then fix the ones above it again (moved down by one)
+    for (int i = givens - 1; i >= index; --i) {
+        deselectRow(choices.at(i));
+    }
+    for (int i = index + 1; i < givens; ++i) {
+        selectRow(choices.at(i));
+        choices[i - 1] = choices.at(i);
+    }
+    depth = --givens;
+    return true;
+}
+
+void ExactCover::releaseSearch() {
+    // Levels above fixed rows are fully covered rows, whether search found a solution or stopped early
+    for (int i = depth - 1; i >= givens; --i) {
+        deselectRow(choices.at(i));
+    }
+    depth = givens;
+}
+
+void ExactCover::reset() {
+    build();
+
+    // Links of every row on the stack are covered, undo in reverse order
+    for (int i = depth - 1; i >= 0; --i) {
+        deselectRow(choices.at(i));
+    }
+    givens = 0;
+    depth = 0;
+}
+
+bool ExactCover::solve() {
+    build();
+    startSearch();
+    bool solved = search();
+    finishSearch();
+    return solved;
+}
+
+int ExactCover::columnRows(int column) const {
+    Q_ASSERT(built && column >= 0 && column < columns);
+    return columnSize[1 + column];
+}
+
+bool ExactCover::isCovered(int column) const {
+    Q_ASSERT(built && column >= 0 && column < columns);
+    int col = 1 + column; // Column nodes follow head
+    return right[left[col]] != col;
+}
+
+QVector<int> ExactCover::solution() const {
+    QVector<int> ids;
+    ids.reserve(depth);
+    for (int i = 0; i < depth; ++i) {
+        ids.append(rowId[choices.at(i)]);
+    }
+    return ids;
+}
+
+const ExactCover::SearchStats &ExactCover::stats() const {
+    return searchStats;
+}
+
+quint64 ExactCover::nodesVisited() const {
+    return visited;
+}
+
+void ExactCover::setBudget(quint64 nodes, qint64 milliseconds) {
+    nodeBudget = nodes;
+    timeBudget = milliseconds;
+}
+
+ExactCover::Interruption ExactCover::interruption() const {
+    return stopReason;
+}
+
+void ExactCover::setCancel(const std::atomic<bool> *cancel) {
+    this->cancel = cancel;
+}
+
+void ExactCover::setProgress(std::atomic<quint64> *progress) {
+    this->progress = progress;
+}
+
+void ExactCover::setHeuristic(const Heuristic &heuristic) {
+    this->heuristic = heuristic;
+    prepareHeuristic();
+}
+
+const ExactCover::Heuristic &ExactCover::currentHeuristic() const {
+    return heuristic;
+}
+
+quint64 ExactCover::countSolutions(quint64 limit) {
+    build();
+    startSearch();
+
+    // Keep searching after each solution until exhausted or limit reached
+    // Search unwinds past a solution when resumed, so rows of the last one are kept aside
+    quint64 count = 0;
+    int foundDepth = givens;
+    bool atSolution = false;
+    for (bool found = search(); found; found = search(true)) {
+        if (++count == limit) {
+            atSolution = true;
+            break;
+        }
+        if (lastFound.size() != choices.size()) {
+            lastFound.resize(choices.size());
+        }
+        std::copy(choices.constBegin() + givens, choices.constBegin() + depth, lastFound.begin() + givens);
+        foundDepth = depth;
+    }
+
+    // Bring stack and links back to the last solution (rows on the stack are covered)
+    if (count > 0 && !atSolution) {
+        releaseSearch();
+        for (int i = givens; i < foundDepth; ++i) {
+            choices[i] = lastFound.at(i);
+            selectRow(choices.at(i));
+        }
+        depth = foundDepth;
+    }
+
+    finishSearch();
+    return count;
+}
+
+bool ExactCover::hasUniqueSolution() {
+    return countSolutions(2) == 1 && stopReason == NotInterrupted;
+}
+
+quint64 ExactCover::enumerateSolutions(const std::function<bool(const SolutionView &)> &callback) {
+    build();
+    startSearch();
+
+    // View stays valid for all solutions, as it only points to the search stack
+    // (detached first, a copied solver may still share the stack of its source until search writes to it)
+    SolutionView view(choices.data(), rowId);
+
+    quint64 count = 0;
+    for (bool found = search(); found; found = search(true)) {
+        ++count;
+        view.count = depth;
+        if (!callback(view)) {
+            break;
+        }
+    }
+
+    finishSearch();
+    return count;
+}
+
+// Parallel
+bool ExactCover::solveParallel(int threads) {
+    return searchParallel(1, threads) > 0;
+}
+
+quint64 ExactCover::countSolutionsParallel(quint64 limit, int threads) {
+    return searchParallel(limit, threads);
+}
+
+bool ExactCover::solvePortfolio(int threads) {
+    build();
+    startSearch();
+
+    if (threads < 1) {
+        threads = QThread::idealThreadCount();
+    }
+
+    std::atomic<bool> stop(false);
+    QMutex resultMutex;
+    bool haveResult = false;
+    bool solved = false;
+    Interruption interrupted = NotInterrupted;
+
+    // Each worker owns a copy of the solver (links after covering fixed rows) and searches the whole tree
+    auto worker = [&](int index) {
+        // Copied under lock, as the deciding search writes its solution into own stack
+        QMutexLocker copyLocker(&resultMutex);
+        ExactCover solver(*this);
+        copyLocker.unlock();
+        solver.visited = 0; // Main solver accumulates finished workers
+        solver.stopReason = NotInterrupted; // Main solver may already hold interruption of a finished worker
+        solver.cancel = cancel;
+        solver.stop = &stop;
+        solver.nodeBudget = nodeBudget != 0 ? qMax<quint64>(1, nodeBudget / threads) : 0;
+        solver.nextPoll = solver.nodeBudget != 0 ? qMin<quint64>(PollInterval, solver.nodeBudget + 1) : PollInterval;
+        solver.timeBudget = timeBudget;
+        solver.deadline = deadline;
+
+        // First worker keeps set heuristic (deterministic by default), others diversify
+        Heuristic diversified = heuristic;
+        if (index > 0) {
+            diversified.randomTieBreak = true;
+            diversified.seed = heuristic.seed + index;
+            diversified.degreeOrder = heuristic.degreeOrder != (index % 2 == 0);
+        }
+        solver.setHeuristic(diversified);
+
+        bool found = !solver.poll() && solver.search();
+
+        // Search that found a solution or ran to completion decides, stop is only set once decided,
+        // so searches stopped by it never get here first
+        QMutexLocker locker(&resultMutex);
+        if (!haveResult && (found || solver.stopReason == NotInterrupted)) {
+            haveResult = true;
+            solved = found;
+            if (found) {
+                depth = solver.depth;
+                std::copy(solver.choices.constBegin(), solver.choices.constBegin() + depth, choices.begin());
+            }
+            stop = true;
+        } else if (solver.stopReason != NotInterrupted) {
+            interrupted = solver.stopReason;
+        }
+        visited += solver.visited;
+        DLX_STAT(searchStats.merge(solver.searchStats));
+    };
+
+    QList<std::thread *> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.append(new std::thread(worker, i));
+    }
+    for (auto &thread : pool) {
+        thread->join();
+        delete thread;
+    }
+
+    // Interrupted only if no search decided
+    if (!haveResult) {
+        stopReason = interrupted;
+    }
+
+    // Bring own links in line with the kept solution (rows on the stack are covered)
+    for (int i = givens; i < depth; ++i) {
+        selectRow(choices.at(i));
+    }
+    finishSearch();
+    return solved;
+}
+
+quint64 ExactCover::searchParallel(quint64 limit, int threads) {
+    build();
+    startSearch();
+
+    if (threads < 1) {
+        threads = QThread::idealThreadCount();
+    }
+
+    // Expand top levels of the search tree into independent subtrees
+    QList<QVector<int>> prefixes = splitSearch(threads * TasksPerThread);
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> nextTask(0);
+    std::atomic<quint64> count(0);
+    QMutex resultMutex;
+    bool haveResult = false;
+    int base = givens;
+
+    // Each worker owns a copy of the solver (links after covering fixed rows) and pulls subtrees until none are left
+    auto worker = [&]() {
+        // Copied under lock, as the first solution found is written into own stack
+        QMutexLocker copyLocker(&resultMutex);
+        ExactCover solver(*this);
+        copyLocker.unlock();
+        solver.visited = 0; // Main solver accumulates finished workers
+        solver.stopReason = NotInterrupted; // Main solver may already hold interruption of a finished worker
+        solver.cancel = cancel;
+        solver.stop = &stop;
+        solver.nodeBudget = nodeBudget != 0 ? qMax<quint64>(1, nodeBudget / threads) : 0;
+        solver.nextPoll = solver.nodeBudget != 0 ? qMin<quint64>(PollInterval, solver.nodeBudget + 1) : PollInterval;
+        solver.timeBudget = timeBudget;
+        solver.deadline = deadline;
+        solver.setHeuristic(heuristic);
+
+        // Budget stop is only reported by the poll that hits it, so interruption is checked before polling again
+        int task;
+        while (solver.stopReason == NotInterrupted && !solver.poll() && (task = nextTask++) < prefixes.size()) {
+            // Fix subtree prefix below search (same as fixed rows)
+            const QVector<int> &prefix = prefixes.at(task);
+            for (int row : prefix) {
+                solver.selectRow(row);
+                solver.choices[solver.givens++] = row;
+            }
+            solver.depth = solver.givens;
+
+            for (bool found = solver.search(); found; found = solver.search(true)) {
+                quint64 total = ++count;
+
+                // Keep first solution found
+                QMutexLocker locker(&resultMutex);
+                if (!haveResult) {
+                    haveResult = true;
+                    depth = solver.depth;
+                    std::copy(solver.choices.constBegin(), solver.choices.constBegin() + depth, choices.begin());
+                }
+                locker.unlock();
+
+                if (limit != 0 && total >= limit) {
+                    stop = true;
+                }
+            }
+
+            // Links are left mid-search when cancelled or out of budget, solver is discarded anyway
+            if (solver.stopReason != NotInterrupted) {
+                break;
+            }
+
+            // Release rows chosen by search (still covered after a solution or a stop), then subtree prefix
+            solver.releaseSearch();
+            for (int i = prefix.size() - 1; i >= 0; --i) {
+                solver.deselectRow(prefix.at(i));
+            }
+            solver.givens = base;
+            solver.depth = base;
+        }
+
+        QMutexLocker locker(&resultMutex);
+        visited += solver.visited;
+        if (solver.stopReason != NotInterrupted) {
+            stopReason = solver.stopReason;
+        }
+        DLX_STAT(searchStats.merge(solver.searchStats));
+    };
+
+    QList<std::thread *> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.append(new std::thread(worker));
+    }
+    for (auto &thread : pool) {
+        thread->join();
+        delete thread;
+    }
+
+    // Bring own links in line with the kept solution (rows on the stack are covered)
+    for (int i = givens; i < depth; ++i) {
+        selectRow(choices.at(i));
+    }
+    finishSearch();
+
+    // Workers may overshoot limit before noticing stop
+    quint64 total = count;
+    return (limit != 0 && total > limit) ? limit : total;
+}
+
+QList<QVector<int>> ExactCover::splitSearch(int tasks) {
+    QList<QVector<int>> prefixes = {QVector<int>()};
+
+    // Breadth-first expansion, one level at a time, until enough subtrees or tree fully solved
+    for (int level = 0; level < MaxSplitDepth && prefixes.size() < tasks; ++level) {
+        QList<QVector<int>> expanded;
+        bool grown = false;
+
+        for (auto &prefix : prefixes) {
+            for (int row : prefix) {
+                selectRow(row);
+            }
+
+            if (right[head] == head) {
+                // Already a solution, keep as is
+                expanded.append(prefix);
+            } else {
+                // Branch on the same column the search would choose (dead ends produce no subtrees)
+                int col = chooseNextColumn();
+                for (int row = down[col]; row != col; row = down[row]) {
+                    QVector<int> branch = prefix;
+                    branch.append(row);
+                    expanded.append(branch);
+                }
+                grown = true;
+            }
+
+            for (int i = prefix.size() - 1; i >= 0; --i) {
+                deselectRow(prefix.at(i));
+            }
+        }
+
+        prefixes = expanded;
+        if (!grown) {
+            break;
+        }
+    }
+
+    return prefixes;
+}
+
+// Search Stats
+void ExactCover::SearchStats::reset() {
+    nodes = 0;
+    covers = 0;
+    uncovers = 0;
+    updates = 0;
+    backtracks = 0;
+    maxDepth = 0;
+    levelNodes.clear();
+    levelBranches.clear();
+}
+
+void ExactCover::SearchStats::visit(int level, int branches) {
+    ++nodes;
+    if (level >= levelNodes.size()) {
+        levelNodes.resize(level + 1);
+        levelBranches.resize(level + 1);
+        maxDepth = level;
+    }
+    ++levelNodes[level];
+    levelBranches[level] += branches;
+}
+
+void ExactCover::SearchStats::merge(const SearchStats &other) {
+    nodes += other.nodes;
+    covers += other.covers;
+    uncovers += other.uncovers;
+    updates += other.updates;
+    backtracks += other.backtracks;
+    maxDepth = qMax(maxDepth, other.maxDepth);
+    if (other.levelNodes.size() > levelNodes.size()) {
+        levelNodes.resize(other.levelNodes.size());
+        levelBranches.resize(other.levelNodes.size());
+    }
+    for (int i = 0; i < other.levelNodes.size(); ++i) {
+        levelNodes[i] += other.levelNodes.at(i);
+        levelBranches[i] += other.levelBranches.at(i);
+    }
+}
+
+double ExactCover::SearchStats::branchingFactor(int level) const {
+    if (level < 0 || level >= levelNodes.size() || levelNodes.at(level) == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(levelBranches.at(level)) / levelNodes.at(level);
+}
+
+// Solution View
+ExactCover::SolutionView::SolutionView(const int *nodes, const int *rowIds) : nodes(nodes), rowIds(rowIds), count(0) {}
+
+int ExactCover::SolutionView::size() const {
+    return count;
+}
+
+int ExactCover::SolutionView::rowId(int i) const {
+    return rowIds[nodes[i]];
+}
+
+// DLX
+void ExactCover::coverColumn(int col) {
+    DLX_STAT(++searchStats.covers);
+
+    // Remove column
+    left[right[col]] = left[col];
+    right[left[col]] = right[col];
+    if (col <= bucketLimit) {
+        bucketRemove(col);
+    }
+
+    // Remove all rows in the column from other columns they are in
+    for (int node = down[col]; node != col; node = down[node]) {
+        for (int tmp = right[node]; tmp != node; tmp = right[tmp]) {
+            down[up[tmp]] = down[tmp];
+            up[down[tmp]] = up[tmp];
+            int other = column[tmp];
+            int size = --columnSize[other];
+            if (other <= bucketLimit) {
+                bucketRemove(other);
+                bucketInsert(other, size);
+                minBucket = qMin(minBucket, size);
+            }
+            DLX_STAT(++searchStats.updates);
+        }
+    }
+}
+
+void ExactCover::uncoverColumn(int col) {
+    DLX_STAT(++searchStats.uncovers);
+
+    // Take advantage of the fact that every node that has been removed retains information about its neighbors
+
+    // Re-add all rows in the column from other columns they were in
+    for (int node = up[col]; node != col; node = up[node]) {
+        for (int tmp = left[node]; tmp != node; tmp = left[tmp]) {
+            int other = column[tmp];
+            int size = ++columnSize[other];
+            if (other <= bucketLimit) {
+                bucketRemove(other);
+                bucketInsert(other, size);
+            }
+            down[up[tmp]] = tmp;
+            up[down[tmp]] = tmp;
+            DLX_STAT(++searchStats.updates);
+        }
+    }
+
+    // Re-add column
+    right[left[col]] = col;
+    left[right[col]] = col;
+    if (col <= bucketLimit) {
+        bucketInsert(col, columnSize[col]);
+        minBucket = qMin(minBucket, columnSize[col]);
+    }
+}
+
+bool ExactCover::search(bool resume) {
+    // Iterative Algorithm X, choices[level] holds the row currently tried at that level
+    // or the column node itself when all rows of that level's column have been tried
+    // Levels below givens hold fixed rows
+    int level = givens; // Local copy of depth (not aliased by link array writes)
+    int col = head;
+
+    // Continue after previously found solution by advancing its last choice
+    if (resume) {
+        if (depth == givens) {
+            return false;
+        }
+        level = depth - 1;
+        col = advanceChoice(level);
+    }
+
+    while (true) {
+        if (!resume) {
+            // Exit if cancelled (checked periodically), rows below level stay covered
+            if (++visited == nextPoll && poll()) {
+                depth = level;
+                return false;
+            }
+
+            // Exit if solution found
+            if (right[head] == head) {
+                depth = level;
+                return true;
+            }
+
+            // Exit if search depth bound reached, rows below level stay covered
+            if (level - givens >= MaxSearchDepth) {
+                stopReason = BudgetExhausted;
+                depth = level;
+                return false;
+            }
+
+            // Cover next column (with least number of nodes or the right one)
+            col = chooseNextColumn();
+            DLX_STAT(searchStats.visit(level - givens, columnSize[col]));
+            coverColumn(col);
+            choices[level] = heuristic.degreeOrder ? orderRows(level, col) : down[col];
+        }
+        resume = false;
+
+        // Backtrack while the current level has no more rows to try
+        while (choices.at(level) == col) {
+            // Uncover last column (backtrack)
+            uncoverColumn(col);
+
+            // Exit if all possibilities exhausted
+            if (level == givens) {
+                depth = givens;
+                return false;
+            }
+
+            DLX_STAT(++searchStats.backtracks);
+            col = advanceChoice(--level);
+        }
+
+        // Cover to the right
+        int row = choices.at(level);
+        for (int node = right[row]; node != row; node = right[node]) {
+            coverColumn(column[node]);
+        }
+
+        // Search next depth
+        ++level;
+    }
+}
+
+bool ExactCover::poll() {
+    if (progress != nullptr) {
+        progress->store(visited, std::memory_order_relaxed);
+    }
+
+    // Node budget allows exactly nodeBudget nodes, next check is scheduled no later than the one past it
+    nextPoll = visited + PollInterval;
+    if (nodeBudget != 0) {
+        if (visited > nodeBudget) {
+            --visited; // Node past budget is not searched
+            stopReason = BudgetExhausted;
+            return true;
+        }
+        nextPoll = qMin(nextPoll, nodeBudget + 1);
+    }
+
+    if (cancel != nullptr && cancel->load(std::memory_order_relaxed)) {
+        stopReason = Cancelled;
+        return true;
+    }
+    if (timeBudget != 0 && std::chrono::steady_clock::now() >= deadline) {
+        stopReason = BudgetExhausted;
+        return true;
+    }
+    return stop != nullptr && stop->load(std::memory_order_relaxed);
+}
+
+void ExactCover::startSearch() {
+    releaseSearch();
+    visited = 0;
+    nextPoll = nodeBudget != 0 ? qMin<quint64>(PollInterval, nodeBudget + 1) : PollInterval;
+    stopReason = NotInterrupted;
+    if (timeBudget != 0) {
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeBudget);
+    }
+    DLX_STAT(searchStats.reset());
+    if (progress != nullptr) {
+        progress->store(0, std::memory_order_relaxed);
+    }
+    prepareHeuristic();
+}
+
+void ExactCover::finishSearch() {
+    if (progress != nullptr) {
+        progress->store(visited, std::memory_order_relaxed);
+    }
+}
+
+void ExactCover::selectRow(int row) {
+    coverColumn(column[row]);
+    for (int node = right[row]; node != row; node = right[node]) {
+        coverColumn(column[node]);
+    }
+}
+
+void ExactCover::deselectRow(int row) {
+    for (int node = left[row]; node != row; node = left[node]) {
+        uncoverColumn(column[node]);
+    }
+    uncoverColumn(column[row]);
+}
+
+int ExactCover::advanceChoice(int level) {
+    // Remove last solution (backtrack)
+    int row = choices.at(level);
+
+    // Uncover to the left (backtrack)
+    for (int node = left[row]; node != row; node = left[node]) {
+        uncoverColumn(column[node]);
+    }
+
+    // Advance to next row in the same column (in degree order if ordered)
+    int col = column[row];
+    if (heuristic.degreeOrder) {
+        int next = orderNext[level]++;
+        choices[level] = next < orderEnd.at(level) ? rowOrder.at(next) : col;
+    } else {
+        choices[level] = down[row];
+    }
+    return col;
+}
+
+int ExactCover::orderRows(int level, int col) {
+    // Slice of level starts where the one of previous level ends
+    int start = level == givens ? 0 : orderEnd.at(level - 1);
+    int end = start;
+    int *order = rowOrder.data();
+    int *degrees = rowDegree.data();
+
+    for (int row = down[col]; row != col; row = down[row], ++end) {
+        // Degree is the number of rows left in the other columns of row (removed if it is chosen)
+        int degree = 0;
+        for (int node = right[row]; node != row; node = right[node]) {
+            degree += columnSize[column[node]];
+        }
+
+        // Insertion sort (columns are short), stable for equal degrees
+        int i = end;
+        for (; i > start && degrees[i - 1] > degree; --i) {
+            order[i] = order[i - 1];
+            degrees[i] = degrees[i - 1];
+        }
+        order[i] = row;
+        degrees[i] = degree;
+    }
+
+    orderNext[level] = start + 1;
+    orderEnd[level] = end;
+    return end > start ? order[start] : col;
+}
+
+void ExactCover::prepareHeuristic() {
+    random.seed(static_cast<std::minstd_rand::result_type>(heuristic.seed % std::minstd_rand::modulus));
+    // Stacks sized for rows and levels of current matrix (assignment or rebuild may change either)
+    if (heuristic.degreeOrder && (rowOrder.size() != rows || orderNext.size() != columns)) {
+        rowOrder.fill(0, rows);
+        rowDegree.fill(0, rows);
+        orderNext.fill(0, columns);
+        orderEnd.fill(0, columns);
+    }
+}
+
+// Helpers
+void ExactCover::attachLinks() {
+    up = links.data();
+    down = up + nodeCount;
+    left = down + nodeCount;
+    right = left + nodeCount;
+    column = right + nodeCount;
+    rowId = column + nodeCount;
+    columnSize = rowId + nodeCount;
+    rowNode = columnSize + columns + 2;
+    bucketNext = rowNode + rows;
+    bucketPrev = bucketNext + bucketHeads + maxColumnSize + 1;
+}
+
+void ExactCover::bucketRemove(int col) {
+    bucketNext[bucketPrev[col]] = bucketNext[col];
+    bucketPrev[bucketNext[col]] = bucketPrev[col];
+}
+
+void ExactCover::bucketInsert(int col, int size) {
+    int bucket = bucketHeads + size;
+    bucketNext[col] = bucketNext[bucket];
+    bucketPrev[col] = bucket;
+    bucketPrev[bucketNext[bucket]] = col;
+    bucketNext[bucket] = col;
+}
+
+int ExactCover::chooseNextColumn() {
+    if (bucketLimit != 0) {
+        // Minimum is only lowered eagerly (on cover), raise it past buckets emptied since
+        int bucket = bucketHeads + minBucket;
+        while (bucketNext[bucket] == bucket) {
+            ++minBucket;
+            ++bucket;
+        }
+
+        // Random tie-break samples only the first columns of the bucket (uniformly, reservoir sampling)
+        int col = bucketNext[bucket];
+        if (heuristic.randomTieBreak) {
+            int ties = 1;
+            for (int node = bucketNext[col]; node != bucket && ties < RandomTieCandidates; node = bucketNext[node]) {
+                if (random() % ++ties == 0) {
+                    col = node;
+                }
+            }
+        }
+        return col;
+    }
+
+    // No column can beat 0 nodes, and with 1 node the outcome is the same as choosing a 0 found further right
+    // (that column stays empty, so the forced row dead ends), only solution order matters
+    int col = right[head];
+    if (heuristic.randomTieBreak) {
+        // Uniformly random one of the columns with least nodes (reservoir sampling)
+        int ties = 1;
+        for (int node = right[col]; node != head && columnSize[col] > 1; node = right[node]) {
+            if (columnSize[node] < columnSize[col]) {
+                col = node;
+                ties = 1;
+            } else if (columnSize[node] == columnSize[col] && random() % ++ties == 0) {
+                col = node;
+            }
+        }
+        return col;
+    }
+
+    for (int node = right[col]; node != head && columnSize[col] > 1; node = right[node]) {
+        // Select if less values in current right column than in original right column
+        if (columnSize[node] < columnSize[col]) {
+            col = node;
+        }
+    }
+    return col;
+}
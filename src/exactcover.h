@@ -0,0 +1,265 @@
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <random>
+
+// Generic exact cover solver (Knuth's Algorithm X with dancing links)
+// Rows are sparse lists of column indices, identified by row id (insertion order)
+// Primary columns must be covered exactly once, secondary (optional) columns at most once
+class ExactCover {
+public:
+    static const bool StatsEnabled; // Search statistics compiled in (CONFIG += dlx_stats)
+    static const int MaxSearchDepth;
+    static const int MaxSplitDepth; // Maximum search tree levels expanded for parallel search
+    static const int TasksPerThread; // Wanted number of subtrees per thread for parallel search
+    static const int PollInterval; // Search nodes between checks of cancel requests, time budget and progress updates
+    static const int BucketedColumns; // Primary columns from which columns are kept in size buckets (constant-time choice)
+    static const int RandomTieCandidates; // Columns of smallest bucket considered by random tie-break (bucketed problems)
+
+    // Reason the last search stopped before exhausting the search tree (or finding the requested solutions)
+    enum Interruption {
+        NotInterrupted,
+        Cancelled, // Cancel was set
+        BudgetExhausted // Node, time or depth budget ran out (statistics cover the searched part)
+    };
+
+    // Lightweight read-only view of a found solution (fixed and chosen rows), valid only during enumeration callback
+    class SolutionView {
+    public:
+        // Number of rows in solution
+        int size() const;
+        // Row identification of i-th row
+        int rowId(int i) const;
+
+    private:
+        friend class ExactCover;
+        SolutionView(const int *nodes, const int *rowIds);
+
+        const int *nodes;
+        const int *rowIds;
+        int count;
+    };
+
+    // Search statistics (collected only if StatsEnabled, zero otherwise)
+    // Levels are search depths below fixed rows
+    struct SearchStats {
+        quint64 nodes = 0; // Search nodes visited (columns chosen)
+        quint64 covers = 0; // Column cover calls
+        quint64 uncovers = 0; // Column uncover calls
+        quint64 updates = 0; // Node link updates (removals and re-insertions)
+        quint64 backtracks = 0; // Returns to a previous level
+        int maxDepth = 0; // Deepest level visited
+        QVector<quint64> levelNodes; // Search nodes visited per level
+        QVector<quint64> levelBranches; // Sum of rows in chosen columns per level
+
+        void reset();
+        // Records search node at level with given number of rows to try
+        void visit(int level, int branches);
+        // Adds other statistics (parallel search)
+        void merge(const SearchStats &other);
+        // Average number of rows tried per search node at level
+        double branchingFactor(int level) const;
+    };
+
+    // Branching heuristic, always chooses a column with least number of rows (minimum remaining values)
+    // Default is deterministic: leftmost column (first in size bucket) and rows from top to bottom
+    struct Heuristic {
+        bool randomTieBreak = false; // Random column among the ones with least number of rows
+        bool degreeOrder = false; // Rows tried in order of least rows left in their other columns (least constraining first)
+        quint64 seed = 0; // Seed of random tie-break (same seed searches the same tree)
+    };
+
+    // Columns 0 to primaryColumns - 1 are primary, the following secondaryColumns are secondary
+    explicit ExactCover(int primaryColumns = 0, int secondaryColumns = 0);
+    ExactCover(const ExactCover &other); // Link arrays point into own storage
+    // Copies other's links into own storage (in place if of same shape, no allocation)
+    ExactCover &operator=(const ExactCover &other);
+
+    // Builder
+    // Adds row covering given columns, returns its row id (rows are numbered in insertion order)
+    // Rows without columns are not added (returns -1), rows cannot be added once built
+    int addRow(const int *columns, int count);
+    int addRow(const QVector<int> &columns);
+    // Preallocates storage for given number of rows and their column entries (avoids regrowth of large problems)
+    void reserve(int rows, int entries);
+    // Builds links from added rows (called automatically on first fix or search)
+    void build();
+
+    int primaryColumns() const;
+    int secondaryColumns() const;
+    int rowCount() const;
+
+    // Adds row to every solution (rows chosen by last search are released first), returns false if it shares a column
+    // with a row already in
+    bool fixRow(int row);
+    // Removes fixed row (rows chosen by last search are released first), returns false if row is not fixed
+    // Links are restored in reverse order, so rows fixed after it are released and fixed again (cost grows with their number)
+    bool unfixRow(int row);
+    // Removes rows chosen by last search (found or interrupted), keeping fixed rows
+    void releaseSearch();
+    // Removes all fixed and chosen rows (restores links to the built state)
+    void reset();
+
+    // Number of rows left in column (not removed by fixed or chosen rows)
+    int columnRows(int column) const;
+    // Column is covered by a fixed or chosen row
+    bool isCovered(int column) const;
+
+    bool solve();
+    // Row ids of last found solution (fixed rows first)
+    QVector<int> solution() const;
+    // Search statistics of last solve (or accumulated over all solutions when counting or enumerating)
+    const SearchStats &stats() const;
+    // Search nodes visited in last solve (always counted, unlike statistics)
+    quint64 nodesVisited() const;
+
+    // Limits each following search (solve, count, enumeration) to given number of search nodes
+    // and milliseconds of wall time (0 for no limit), search stops as if no further solution exists
+    // Node budget is exact, time budget is checked every PollInterval nodes, parallel search splits node budget between threads
+    void setBudget(quint64 nodes, qint64 milliseconds);
+    // Reason the last search stopped early (NotInterrupted if it ran to completion)
+    Interruption interruption() const;
+
+    // Search stops (as if no further solution exists) once cancel is set, checked every PollInterval nodes
+    // Pointer must stay valid while searching (nullptr to detach), not copied with the solver
+    void setCancel(const std::atomic<bool> *cancel);
+    // Search publishes number of visited nodes into progress every PollInterval nodes and when finished
+    // Pointer must stay valid while searching (nullptr to detach), not copied with the solver
+    void setProgress(std::atomic<quint64> *progress);
+
+    // Heuristic of each following search (tie-break is reseeded on every search), not copied with the solver
+    void setHeuristic(const Heuristic &heuristic);
+    const Heuristic &currentHeuristic() const;
+
+    // Counts solutions, stopping as soon as limit is reached (0 for no limit)
+    // solution() afterwards returns the last one found (also after exhausting the search or running out of budget)
+    quint64 countSolutions(quint64 limit = 0);
+    // Checks if problem has exactly one solution (stops searching at second one)
+    // False if search was interrupted before deciding
+    bool hasUniqueSolution();
+    // Streams all solutions to callback without copying, callback returns false to stop the search
+    // Returns number of solutions passed to callback
+    quint64 enumerateSolutions(const std::function<bool(const SolutionView &)> &callback);
+
+    // Parallel search, splits top levels of the search tree into subtrees searched by per-thread solver copies
+    // Threads less than 1 uses ideal thread count
+    // Solves on all threads, cancelling all as soon as one finds a solution
+    bool solveParallel(int threads = 0);
+    // Counts solutions on all threads, cancelling all as soon as limit is reached (0 for no limit)
+    quint64 countSolutionsParallel(quint64 limit = 0, int threads = 0);
+    // Portfolio search, every thread searches the whole tree with a differently seeded random tie-break
+    // (first thread keeps set heuristic, every second one also flips row order), first search to finish decides
+    // Cuts heavy-tailed run times of hard problems, where one unlucky branching order can take orders of magnitude longer
+    // Threads less than 1 uses ideal thread count
+    bool solvePortfolio(int threads = 0);
+
+private:
+    // Rows added before build (row i covers rowColumns[rowStart[i]] to rowColumns[rowStart[i + 1] - 1])
+    QVector<int> rowStart;
+    QVector<int> rowColumns;
+    bool built;
+
+    // Size
+    int primary;
+    int columns; // Primary and secondary
+    int rows;
+
+    // Links
+    // Nodes are indices into parallel arrays (structure of arrays), all carved out of a single allocation
+    // Index 0 is head of primary columns, indices 1 to columns are column headers,
+    // columns + 1 is head of secondary columns (never chosen), the rest are matrix nodes
+    static const int head = 0;
+    int secondaryHead;
+    int nodeCount;
+    QVector<int> links; // Storage of all arrays below
+    int *up;
+    int *down;
+    int *left;
+    int *right;
+    int *column; // Column header of node
+    int *rowId; // Row identification of node
+    int *columnSize; // Number of nodes in column (indexed by column header)
+    int *rowNode; // First node of row (indexed by row identification)
+    // Size buckets (large problems only, see BucketedColumns)
+    // Uncovered primary columns are kept in doubly linked lists per column size, so the smallest column is found
+    // without scanning all columns, bucket of size s has its list head at index bucketHeads + s
+    int *bucketNext;
+    int *bucketPrev;
+    int bucketHeads;
+    int maxColumnSize; // Largest column size after build (number of buckets - 1)
+    int bucketLimit; // Columns up to this header index are bucketed (primary columns if bucketed, 0 otherwise)
+    int minBucket; // No bucket below this one holds a column (may lag behind after uncovers)
+    QVector<int> choices; // Preallocated search stack of chosen rows, fixed rows at the bottom
+    QVector<int> lastFound; // Chosen rows of last solution found while counting (same layout as choices, not copied)
+    int givens; // Number of fixed rows
+    int depth; // Current search depth (number of chosen rows, including fixed)
+    const std::atomic<bool> *cancel; // Stops search when set (external request)
+    const std::atomic<bool> *stop; // Stops search when set (parallel search, solution found by another thread)
+    std::atomic<quint64> *progress; // Receives visited nodes (live progress)
+    quint64 visited; // Search nodes visited since search started
+    quint64 nextPoll; // Value of visited at which search checks cancel requests and budgets next
+    quint64 nodeBudget; // Maximum search nodes (0 for no limit)
+    qint64 timeBudget; // Maximum milliseconds of search (0 for no limit)
+    std::chrono::steady_clock::time_point deadline; // End of time budget of current search
+    Interruption stopReason;
+    SearchStats searchStats;
+    Heuristic heuristic;
+    std::minstd_rand random; // Tie-break
+    // Degree ordered rows of chosen columns, one slice per level stacked on top of each other
+    // (rows of columns chosen along one search path are distinct, so all slices fit into one entry per row)
+    QVector<int> rowOrder;
+    QVector<int> rowDegree; // Sort key of rows in rowOrder
+    QVector<int> orderNext; // Per level index of next row to try in rowOrder
+    QVector<int> orderEnd; // Per level index past its last row in rowOrder
+
+    // DLX
+    // Remove a column from the matrix
+    void coverColumn(int col);
+    // Reverse of cover
+    void uncoverColumn(int col);
+    // Runs DLX search (iterative, with explicit stack)
+    // Resume continues after previously found solution
+    // Returns false if no (further) solution exists or search depth bound is reached
+    bool search(bool resume = false);
+    // Uncovers row chosen at level and moves to the next row in its column, returns that column
+    int advanceChoice(int level);
+    // Stores rows of column chosen at level sorted by degree, returns first of them (column if empty)
+    int orderRows(int level, int col);
+    // Allocates row order stack if degree ordered (shape may change after heuristic is set)
+    void prepareHeuristic();
+    // Checks cancel requests and budgets and publishes progress, returns true if search should stop
+    // Schedules next check
+    bool poll();
+    // Releases rows chosen by previous search and starts counting visited nodes of a new search (and its time budget)
+    void startSearch();
+    // Publishes final number of visited nodes
+    void finishSearch();
+    // Covers all columns of row (adds row to partial solution)
+    void selectRow(int row);
+    // Reverse of select
+    void deselectRow(int row);
+
+    // Parallel
+    // Runs parallel search until limit solutions found (0 for no limit), returns number of solutions
+    quint64 searchParallel(quint64 limit, int threads);
+    // Expands top levels of the search tree into at least given number of subtrees (if possible)
+    // Returns row prefixes of subtrees
+    QList<QVector<int>> splitSearch(int tasks);
+
+    // Helpers
+    // Points link arrays into link storage
+    void attachLinks();
+    // Moves bucketed column out of its size bucket or into bucket of given size
+    void bucketRemove(int col);
+    void bucketInsert(int col, int size);
+    // Chooses primary column with least number of nodes (leftmost or random one, see Heuristic)
+    // Choosing the column with the least number of nodes decreases the branching of the algorithm
+    // Scan stops early at a column with 0 or 1 nodes (dead end or forced row), bucketed problems take first
+    // column of the smallest non-empty bucket instead of the leftmost one (or a random one of its first columns)
+    int chooseNextColumn();
+};
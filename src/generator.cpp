@@ -0,0 +1,154 @@
+#include "generator.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+Generator::Generator(int size, quint64 seed)
+    : size(size), sizeSqrt(static_cast<int>(std::sqrt(size))), targetGivens(0), random(seed), dlx(Grid()) {
+    // Propagation makes most uniqueness checks trivial (removed value is often forced again)
+    dlx.setPropagation(true);
+}
+
+void Generator::setSeed(quint64 seed) {
+    random.seed(seed);
+}
+
+void Generator::setTargetGivens(int givens) {
+    targetGivens = givens;
+}
+
+void Generator::setCheckBudget(quint64 nodes) {
+    checkBudget.nodes = nodes;
+    dlx.setBudget(checkBudget);
+}
+
+Grid Generator::fullGrid() {
+    // Complete a grid with random first row (DLX completion itself is deterministic)
+    QVector<int> firstRow = permutation(size);
+    Grid sudoku;
+    for (int i = 0; i < size; ++i) {
+        GridRow row;
+        for (int j = 0; j < size; ++j) {
+            row.append(i == 0 ? firstRow.at(j) + 1 : -1);
+        }
+        sudoku.append(row);
+    }
+
+    // Completion is not limited by check budget (empty grids solve without backtracking)
+    dlx.setBudget(Solver::Budget());
+    dlx.reset(sudoku);
+    bool solved = dlx.solve();
+    dlx.setBudget(checkBudget);
+    if (!solved) {
+        return Grid();
+    }
+    Grid completed = dlx.solution();
+
+    // Shuffle rows within bands, bands, columns within stacks and stacks (all keep the grid valid)
+    QVector<int> rows = linePermutation();
+    QVector<int> columns = linePermutation();
+    bool transpose = random() & 1;
+
+    Grid shuffled;
+    shuffled.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        GridRow row;
+        row.reserve(size);
+        for (int j = 0; j < size; ++j) {
+            int r = rows.at(transpose ? j : i);
+            int c = columns.at(transpose ? i : j);
+            row.append(completed.at(r).at(c));
+        }
+        shuffled.append(row);
+    }
+
+    return shuffled;
+}
+
+Grid Generator::puzzle() {
+    Grid sudoku = fullGrid();
+    if (sudoku.isEmpty()) {
+        return sudoku;
+    }
+
+    // Try removing each given once, in random order, keeping it if the solution would no longer be unique
+    // Uniqueness check stops searching at the second solution (or when out of budget, keeping the given)
+    int givens = size * size;
+    for (int cell : permutation(size * size)) {
+        if (givens <= targetGivens) {
+            break;
+        }
+
+        int row = cell / size;
+        int column = cell % size;
+        int value = sudoku.at(row).at(column);
+        sudoku[row][column] = -1;
+
+        dlx.reset(sudoku);
+        if (dlx.hasUniqueSolution()) {
+            --givens;
+        } else {
+            sudoku[row][column] = value;
+        }
+    }
+
+    return sudoku;
+}
+
+QVector<Grid> Generator::generate(int size, int count, quint64 seed, int targetGivens, int threads, quint64 checkBudget) {
+    if (threads < 1) {
+        threads = QThread::idealThreadCount();
+    }
+
+    std::atomic<int> next(0);
+    QVector<Grid> puzzles(count);
+    Grid *output = puzzles.data(); // Detach once, workers write disjoint entries
+
+    auto worker = [&]() {
+        Generator generator(size);
+        generator.setTargetGivens(targetGivens);
+        generator.setCheckBudget(checkBudget);
+
+        int i;
+        while ((i = next++) < count) {
+            generator.setSeed(seed + i);
+            output[i] = generator.puzzle();
+        }
+    };
+
+    QList<std::thread *> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.append(new std::thread(worker));
+    }
+    for (auto &thread : pool) {
+        thread->join();
+        delete thread;
+    }
+
+    return puzzles;
+}
+
+QVector<int> Generator::permutation(int n) {
+    QVector<int> values(n);
+    for (int i = 0; i < n; ++i) {
+        values[i] = i;
+    }
+    std::shuffle(values.begin(), values.end(), random);
+    return values;
+}
+
+QVector<int> Generator::linePermutation() {
+    QVector<int> bands = permutation(sizeSqrt);
+    QVector<int> lines;
+    lines.reserve(size);
+    for (int band : bands) {
+        for (int line : permutation(sizeSqrt)) {
+            lines.append(band * sizeSqrt + line);
+        }
+    }
+    return lines;
+}
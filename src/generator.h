@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QVector>
+
+#include <random>
+
+#include "dlx.h"
+
+// Generator of proper puzzles (exactly one solution) of any NxN size, built on DLX
+// Completed grid is randomized, then givens are removed in random order as long as the solution stays unique
+class Generator {
+public:
+    explicit Generator(int size, quint64 seed = 0);
+
+    // Restarts random sequence (same seed and size give the same puzzles)
+    void setSeed(quint64 seed);
+    // Stops removing givens once this many are left (0 or less removes as many as possible)
+    // Fewer givens generally means a harder puzzle
+    void setTargetGivens(int givens);
+    // Limits search nodes of each uniqueness check (0 for no limit), given is kept if check runs out of budget
+    // Bounds generation time of large grids with few givens, where single checks can take very long
+    void setCheckBudget(quint64 nodes);
+
+    // Random completed grid
+    Grid fullGrid();
+    // Random proper puzzle
+    Grid puzzle();
+
+    // Generates puzzles on all threads (threads less than 1 uses ideal thread count)
+    // Puzzle i is generated from seed + i, so results do not depend on number of threads
+    static QVector<Grid> generate(int size, int count, quint64 seed, int targetGivens = 0, int threads = 0, quint64 checkBudget = 0);
+
+private:
+    int size;
+    int sizeSqrt;
+    int targetGivens;
+    Solver::Budget checkBudget; // Budget of uniqueness checks
+    std::mt19937_64 random;
+    DLX dlx; // Reused for completing grids and uniqueness checks
+
+    // Random permutation of 0 to n - 1
+    QVector<int> permutation(int n);
+    // Random permutation of rows (or columns) keeping them within their band (or stack), bands shuffled too
+    QVector<int> linePermutation();
+};
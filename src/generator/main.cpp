@@ -0,0 +1,122 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+#include <QDebug>
+
+#include <chrono>
+
+#include "generator.h"
+#include "gridformat.h"
+#include "puzzlefile.h"
+
+// Writes puzzles in dotted string format (one per line, delimited format for sizes above 49x49)
+static bool writeDotted(const QString &fileName, const QVector<Grid> &puzzles) {
+    QFile file;
+    bool opened;
+    if (fileName.isEmpty()) {
+        opened = file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    } else {
+        file.setFileName(fileName);
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Text);
+    }
+
+    if (!opened) {
+        qCritical() << "Failed to open output";
+        return false;
+    }
+
+    QTextStream out(&file);
+    for (auto &sudoku : puzzles) {
+        out << GridFormat::toString(sudoku) << '\n';
+    }
+    return true;
+}
+
+// Writes puzzles in packed binary puzzle format
+static bool writeBinary(const QString &fileName, int size, const QVector<Grid> &puzzles) {
+    PuzzleWriter out;
+    if (fileName.isEmpty() || !out.open(fileName, size)) {
+        qCritical() << "Failed to open output (binary format requires output file)";
+        return false;
+    }
+
+    for (auto &sudoku : puzzles) {
+        out.write(sudoku);
+    }
+    out.close();
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SudokuDLXGenerator");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generator of proper Sudoku puzzles (exactly one solution).\n"
+                                     "Removes givens from a random completed grid while the solution stays unique.");
+    parser.addHelpOption();
+    QCommandLineOption countOption({"n", "count"}, "Number of puzzles (default: 1000).", "count", "1000");
+    QCommandLineOption sizeOption({"s", "size"}, "Grid size N for NxN grid (default: 9).", "size", "9");
+    QCommandLineOption givensOption({"g", "givens"}, "Stop removing at this many givens, more is easier (default: as few as possible).", "count", "0");
+    QCommandLineOption seedOption("seed", "Random seed, puzzle i is generated from seed + i (default: 1).", "seed", "1");
+    QCommandLineOption budgetOption({"b", "check-budget"}, "Search nodes per uniqueness check, given is kept if exceeded (default: no limit).", "nodes", "0");
+    QCommandLineOption threadsOption({"j", "threads"}, "Number of worker threads (default: all cores).", "count");
+    QCommandLineOption formatOption({"f", "format"}, "Output format: dotted (delimited above 49x49) or binary (default: dotted).", "format", "dotted");
+    QCommandLineOption outputOption({"o", "output"}, "Output file (default: standard output, dotted format only).", "file");
+    parser.addOption(countOption);
+    parser.addOption(sizeOption);
+    parser.addOption(givensOption);
+    parser.addOption(seedOption);
+    parser.addOption(budgetOption);
+    parser.addOption(threadsOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.process(app);
+
+    int count = qMax(0, parser.value(countOption).toInt());
+    int size = parser.value(sizeOption).toInt();
+    if (!GridFormat::isValidSize(size)) {
+        qCritical() << "Invalid grid size! Only NxN grids supported.";
+        return 1;
+    }
+
+    QString format = parser.value(formatOption);
+    if (format != "dotted" && format != "binary") {
+        qCritical() << "Unknown format" << format;
+        return 1;
+    }
+
+    int threads = QThread::idealThreadCount();
+    if (parser.isSet(threadsOption)) {
+        threads = qMax(1, parser.value(threadsOption).toInt());
+    }
+
+    // Generate
+    auto benchStart = std::chrono::high_resolution_clock::now();
+    QVector<Grid> puzzles = Generator::generate(size, count, parser.value(seedOption).toULongLong(),
+                                                parser.value(givensOption).toInt(), threads,
+                                                parser.value(budgetOption).toULongLong());
+    auto benchEnd = std::chrono::high_resolution_clock::now();
+    double bench = std::chrono::duration<double>(benchEnd - benchStart).count();
+
+    // Write
+    bool written;
+    if (format == "binary") {
+        written = writeBinary(parser.value(outputOption), size, puzzles);
+    } else {
+        written = writeDotted(parser.value(outputOption), puzzles);
+    }
+
+    if (!written) {
+        return 1;
+    }
+
+    qInfo().noquote() << QString("Generated %1 %2x%2 puzzles in %3 seconds on %4 threads (%5 puzzles/second)")
+                         .arg(count).arg(size).arg(bench).arg(threads)
+                         .arg(bench > 0.0 ? count / bench : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "gridformat.h"
+
+#include <QVector>
+
+#include <cmath>
+
+namespace {
+    // Characters of values in dotted string format, character i encodes value i + 1
+    const char CellCharacters[] = "123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+    // Value of character in dotted string format (-1 if empty or unknown)
+    int cellCharacterValue(char c) {
+        if (c >= '1' && c <= '9') {
+            return c - '0';
+        } else if (c >= 'A' && c <= 'Z') {
+            return c - 'A' + 10;
+        } else if (c >= 'a' && c <= 'z') {
+            return c - 'a' + 36;
+        }
+        return -1;
+    }
+
+    bool isSeparator(QChar c) {
+        return c.isSpace() || c == ',' || c == ';';
+    }
+
+    // Arranges cell values (row-major) into grid
+    // Returns empty grid if number of values is not supported NxN size
+    Grid valuesToGrid(const QVector<int> &values) {
+        Grid sudoku;
+
+        double intpart;
+        if (modf(sqrt(values.size()), &intpart) != 0.0 || !GridFormat::isValidSize(static_cast<int>(intpart))) {
+            return sudoku;
+        }
+
+        int size = static_cast<int>(intpart);
+        sudoku.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            GridRow row;
+            row.reserve(size);
+            for (int j = 0; j < size; ++j) {
+                row.append(values.at(i * size + j));
+            }
+            sudoku.append(row);
+        }
+
+        return sudoku;
+    }
+}
+
+bool GridFormat::isValidSize(int size) {
+    // Exit if size less than 4 or too large for candidate masks
+    if (size < 4 || size > MaxSize) {
+        return false;
+    }
+
+    // Exit if size not perfect square
+    double intpart;
+    return modf(sqrt(size), &intpart) == 0.0;
+}
+
+Grid GridFormat::fromDottedString(const QString &gridStr) {
+    QVector<int> values;
+    values.reserve(gridStr.size());
+    for (int i = 0; i < gridStr.size(); ++i) {
+        values.append(cellCharacterValue(gridStr.at(i).toLatin1()));
+    }
+
+    return valuesToGrid(values);
+}
+
+QString GridFormat::toDottedString(const Grid &sudoku) {
+    const int maxValue = static_cast<int>(sizeof(CellCharacters)) - 1;
+
+    QString gridStr = "";
+    for (auto &row : sudoku) {
+        for (auto &value : row) {
+            if (value < 1 || value > maxValue) {
+                gridStr.append(".");
+            } else {
+                gridStr.append(QLatin1Char(CellCharacters[value - 1]));
+            }
+        }
+    }
+
+    return gridStr;
+}
+
+Grid GridFormat::fromDelimitedString(const QString &gridStr) {
+    QVector<int> values;
+
+    // Tokens consisting of digits only are values, any other tokens are empty cells
+    int value = 0;
+    bool inToken = false;
+    bool number = true;
+    for (int i = 0; i <= gridStr.size(); ++i) {
+        QChar c = i < gridStr.size() ? gridStr.at(i) : QLatin1Char(' ');
+        if (isSeparator(c)) {
+            if (inToken) {
+                values.append(number && value > 0 ? value : -1);
+            }
+            value = 0;
+            inToken = false;
+            number = true;
+        } else {
+            inToken = true;
+            if (c.isDigit() && number) {
+                value = qMin(value * 10 + c.digitValue(), 1 << 16); // Saturate, larger values are invalid anyway
+            } else {
+                number = false;
+            }
+        }
+    }
+
+    return valuesToGrid(values);
+}
+
+QString GridFormat::toDelimitedString(const Grid &sudoku) {
+    QString gridStr = "";
+    for (auto &row : sudoku) {
+        for (auto &value : row) {
+            if (!gridStr.isEmpty()) {
+                gridStr.append(",");
+            }
+            if (value < 1) {
+                gridStr.append(".");
+            } else {
+                gridStr.append(QString::number(value));
+            }
+        }
+    }
+
+    return gridStr;
+}
+
+Grid GridFormat::fromString(const QString &gridStr) {
+    QString trimmed = gridStr.trimmed();
+    for (int i = 0; i < trimmed.size(); ++i) {
+        if (isSeparator(trimmed.at(i))) {
+            return fromDelimitedString(trimmed);
+        }
+    }
+    return fromDottedString(trimmed);
+}
+
+QString GridFormat::toString(const Grid &sudoku) {
+    if (sudoku.size() <= MaxDottedSize) {
+        return toDottedString(sudoku);
+    }
+    return toDelimitedString(sudoku);
+}
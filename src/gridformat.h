@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QString>
+
+#include "dlx.h"
+
+// Grid text formats shared by GUI and headless tools
+// Dotted string format uses one character per cell: '.' (or any other character) for empty cells,
+// 1-9 for values 1 to 9, A-Z for values 10 to 35 and a-z for values 36 to 61 (16x16 uses 1-9 and A-G)
+// Delimited format lists cell values as numbers separated by commas, semicolons or whitespace,
+// with '.' (or any other non-number) for empty cells (5,3,.,.,7,...), suitable for any supported size
+namespace GridFormat {
+    // Largest supported NxN size representable in dotted string format
+    const int MaxDottedSize = 49;
+    // Largest supported NxN size (solvers keep candidates of a cell in 64-bit masks)
+    const int MaxSize = 64;
+
+    // Checks if size is supported NxN size (N perfect square, at least 4 and at most MaxSize)
+    bool isValidSize(int size);
+
+    // Converts dotted string grid (53.2..4...) to int grid
+    // Returns empty grid if length is not supported NxN size
+    Grid fromDottedString(const QString &gridStr);
+    // Converts int grid to dotted string grid (53.2..4...), grid size must be at most MaxDottedSize
+    QString toDottedString(const Grid &sudoku);
+
+    // Converts delimited grid (5,3,.,.,7,...) to int grid
+    // Returns empty grid if number of cells is not supported NxN size
+    Grid fromDelimitedString(const QString &gridStr);
+    // Converts int grid to comma-delimited grid (5,3,.,.,7,...)
+    QString toDelimitedString(const Grid &sudoku);
+
+    // Converts grid in either format to int grid (delimited if it contains a separator, dotted otherwise)
+    Grid fromString(const QString &gridStr);
+    // Converts int grid to dotted string grid if its size allows it, delimited otherwise
+    QString toString(const Grid &sudoku);
+}
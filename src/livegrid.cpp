@@ -0,0 +1,186 @@
+#include "livegrid.h"
+
+const quint64 LiveGrid::DefaultNodeBudget = 20000;
+
+LiveGrid::LiveGrid(int size) : gridSize(0), sizeSqrt(0) {
+    resize(size);
+}
+
+void LiveGrid::resize(int size) {
+    gridSize = size;
+    sizeSqrt = 1;
+    while (sizeSqrt * sizeSqrt < size) {
+        ++sizeSqrt;
+    }
+
+    cells.fill(0, size * size);
+    fixed.fill(false, size * size);
+    valueCounts.fill(0, 3 * size * (size + 1));
+    exactCover = *DLX::exactCoverTemplate(size);
+}
+
+void LiveGrid::clear() {
+    cells.fill(0);
+    fixed.fill(false);
+    valueCounts.fill(0);
+    exactCover.reset();
+}
+
+int LiveGrid::size() const {
+    return gridSize;
+}
+
+QVector<int> LiveGrid::setCell(int row, int column, int value) {
+    int cell = row * gridSize + column;
+    if (value < 1 || value > gridSize) {
+        value = 0;
+    }
+
+    // Exit if unchanged
+    int old = cells.at(cell);
+    if (value == old) {
+        return QVector<int>();
+    }
+
+    QVector<int> changed = {cell};
+    if (old != 0) {
+        if (fixed.at(cell)) {
+            exactCover.unfixRow(rowOf(cell, old));
+            fixed[cell] = false;
+        }
+        countValue(cell, old, -1);
+    }
+
+    cells[cell] = value;
+    if (value != 0) {
+        countValue(cell, value, 1);
+        fixed[cell] = exactCover.fixRow(rowOf(cell, value));
+    }
+
+    // Values left out for duplicating the old value may fit now (only its row, column and region were blocked)
+    int units[3];
+    cellUnits(cell, units);
+    if (old != 0) {
+        for (int unit : units) {
+            for (int k = 0; k < gridSize; ++k) {
+                int other = unitCell(unit, k);
+                if (cells.at(other) == old && !fixed.at(other) && exactCover.fixRow(rowOf(other, old))) {
+                    fixed[other] = true;
+                    changed.append(other);
+                }
+            }
+        }
+    }
+
+    // Changed cells and their peers
+    QVector<bool> marked(gridSize * gridSize, false);
+    for (int changedCell : changed) {
+        cellUnits(changedCell, units);
+        for (int unit : units) {
+            for (int k = 0; k < gridSize; ++k) {
+                marked[unitCell(unit, k)] = true;
+            }
+        }
+    }
+
+    QVector<int> affected;
+    for (int i = 0; i < marked.size(); ++i) {
+        if (marked.at(i)) {
+            affected.append(i);
+        }
+    }
+    return affected;
+}
+
+int LiveGrid::cell(int row, int column) const {
+    return cells.at(row * gridSize + column);
+}
+
+bool LiveGrid::isConflicting(int row, int column) const {
+    int cell = row * gridSize + column;
+    int value = cells.at(cell);
+    if (value == 0) {
+        return false;
+    }
+
+    int units[3];
+    cellUnits(cell, units);
+    for (int unit : units) {
+        if (valueCounts.at(unit * (gridSize + 1) + value) > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int LiveGrid::conflictCount() const {
+    int count = 0;
+    for (int i = 0; i < gridSize; ++i) {
+        for (int j = 0; j < gridSize; ++j) {
+            if (isConflicting(i, j)) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+int LiveGrid::candidates(int row, int column) const {
+    // Cell constraint column holds the candidates of cell that no fixed value removed
+    return cell(row, column) == 0 ? exactCover.columnRows(row * gridSize + column) : 0;
+}
+
+LiveGrid::Solvability LiveGrid::solvability(quint64 nodeBudget) {
+    if (conflictCount() > 0) {
+        return Unsolvable;
+    }
+
+    // Dead ends without search: empty cell without candidates or value without place in a row, column or region
+    for (int col = 0; col < exactCover.primaryColumns(); ++col) {
+        if (!exactCover.isCovered(col) && exactCover.columnRows(col) == 0) {
+            return Unsolvable;
+        }
+    }
+
+    // Search from fixed values, chosen rows are released afterwards (fixed values stay)
+    exactCover.setBudget(nodeBudget, 0);
+    bool solved = exactCover.solve();
+    ExactCover::Interruption interruption = exactCover.interruption();
+    exactCover.releaseSearch();
+
+    if (solved) {
+        return Solvable;
+    }
+    return interruption == ExactCover::NotInterrupted ? Unsolvable : Unknown;
+}
+
+// Helpers
+void LiveGrid::cellUnits(int cell, int *units) const {
+    int row = cell / gridSize;
+    int column = cell % gridSize;
+    units[0] = row;
+    units[1] = gridSize + column;
+    units[2] = 2 * gridSize + (row / sizeSqrt) * sizeSqrt + column / sizeSqrt;
+}
+
+int LiveGrid::unitCell(int unit, int k) const {
+    int index = unit % gridSize;
+    if (unit < gridSize) {
+        return index * gridSize + k;
+    } else if (unit < 2 * gridSize) {
+        return k * gridSize + index;
+    }
+    return ((index / sizeSqrt) * sizeSqrt + k / sizeSqrt) * gridSize + (index % sizeSqrt) * sizeSqrt + k % sizeSqrt;
+}
+
+int LiveGrid::rowOf(int cell, int value) const {
+    return cell * gridSize + value - 1;
+}
+
+void LiveGrid::countValue(int cell, int value, int delta) {
+    int units[3];
+    cellUnits(cell, units);
+    for (int unit : units) {
+        valueCounts[unit * (gridSize + 1) + value] += delta;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QVector>
+
+#include "dlx.h"
+
+// Solver state of a grid being edited (GUI), kept up to date one cell at a time
+// Values are fixed into and released from a persistent exact cover problem of the grid size (links are never rebuilt),
+// so conflicts, candidates and solvability are available after every edit
+// Conflicting values (same value more than once in a row, column or region) stay out of the exact cover problem
+// until the conflict is resolved
+class LiveGrid {
+public:
+    static const quint64 DefaultNodeBudget;
+
+    enum Solvability {
+        Solvable,
+        Unsolvable, // Conflicting values, dead end without search (cell or value without candidates) or search exhausted
+        Unknown // Search ran out of node budget before deciding
+    };
+
+    explicit LiveGrid(int size = 9);
+
+    // Starts over with empty grid of given size (exact cover problem of the size is copied once)
+    void resize(int size);
+    // Empties all cells
+    void clear();
+    int size() const;
+
+    // Sets value of cell (less than 1 or above size empties it)
+    // Returns cells whose state may have changed (cells sharing a row, column or region with a changed cell), row-major
+    QVector<int> setCell(int row, int column, int value);
+    int cell(int row, int column) const;
+
+    // Value of cell is also present in its row, column or region
+    bool isConflicting(int row, int column) const;
+    // Number of cells with conflicting values
+    int conflictCount() const;
+    // Number of values still possible in empty cell, excluded by values currently fixed in the cover (0 for filled cells)
+    // Of conflicting values only the one fixed first excludes, so candidates may change as conflicts are resolved
+    int candidates(int row, int column) const;
+    // Checks if grid can be completed, search is limited to given number of nodes
+    Solvability solvability(quint64 nodeBudget = DefaultNodeBudget);
+
+private:
+    int gridSize;
+    int sizeSqrt;
+    QVector<int> cells; // Values (row-major, 0 if empty)
+    QVector<bool> fixed; // Value of cell is fixed in exact cover problem (not left out for conflicting)
+    QVector<int> valueCounts; // Occurrences of each value per unit (rows, then columns, then regions), size + 1 per unit
+    ExactCover exactCover;
+
+    // Units (row, column, region) of cell
+    void cellUnits(int cell, int *units) const;
+    // Cell at position in unit
+    int unitCell(int unit, int k) const;
+    // Exact cover row of value in cell - Reference DLX::SolutionView
+    int rowOf(int cell, int value) const;
+    // Adjusts counts of value in all units of cell
+    void countValue(int cell, int value, int delta);
+};
@@ -3,13 +3,23 @@
 
 #include <QValidator>
 #include <QInputDialog>
+#include <QtConcurrent>
 
 #include <cmath>
 #include <chrono>
 
-MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow) {
+// Cell styles, conflicting values and empty cells without candidates are highlighted
+static const char *CellStyle = "QLineEdit { border: 1px solid grey; }";
+static const char *HighlightedCellStyle = "QLineEdit { border: 1px solid grey; background-color: #f4c7c3; }";
+
+MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWindow), engine(Solver::DancingLinks), propagation(false), showCandidates(true) {
     ui->setupUi(this);
 
+    // Background solving
+    progressTimer.setInterval(100);
+    connect(&progressTimer, &QTimer::timeout, this, &MainWindow::onSolveProgress);
+    connect(&solveWatcher, &QFutureWatcher<bool>::finished, this, &MainWindow::onSolveFinished);
+
     // Tests
     runTests();
 
@@ -19,6 +29,12 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), ui(new Ui::MainWi
 }
 
 MainWindow::~MainWindow() {
+    // Stop solver still running on worker thread before it gets destroyed
+    if (activeSolver) {
+        control.cancel = true;
+        solveWatcher.waitForFinished();
+    }
+
     delete ui;
 }
 
@@ -80,7 +96,7 @@ bool MainWindow::generateGrid(int size) {
                     QLineEdit *cell = new QLineEdit(widget);
                     cell->setAlignment(Qt::AlignCenter);
                     cell->setFont(QFont(cell->font().family(), cellSize / 2));
-                    cell->setStyleSheet("QLineEdit { border: 1px solid grey; }");
+                    cell->setStyleSheet(CellStyle);
 
                     cell->setValidator(validator);
                     cell->setMinimumSize(cellSize, cellSize);
@@ -94,6 +110,10 @@ bool MainWindow::generateGrid(int size) {
                     int rowIndex = i + si * columnsInRegion;
                     grid[rowIndex].append(cell);
 
+                    // Position for incremental updates of live solver state
+                    cell->setProperty("row", rowIndex);
+                    cell->setProperty("column", j + sj * columnsInRegion);
+
                     connect(cell, &QLineEdit::textEdited, this, &MainWindow::onCellTextEdited);
                 }
             }
@@ -102,6 +122,8 @@ bool MainWindow::generateGrid(int size) {
         }
     }
 
+    liveGrid.resize(size);
+    syncLiveGrid();
     return true;
 }
 
@@ -120,21 +142,76 @@ void MainWindow::resetGrid() {
             cell->setText("");
         }
     }
+    syncLiveGrid();
+}
+
+void MainWindow::syncLiveGrid() {
+    liveGrid.clear();
+    QVector<int> cells;
+    for (int i = 0; i < grid.size(); ++i) {
+        for (int j = 0; j < grid.at(i).size(); ++j) {
+            liveGrid.setCell(i, j, cellValue(grid.at(i).at(j)));
+            cells.append(i * grid.size() + j);
+        }
+    }
+    updateCells(cells);
+}
+
+void MainWindow::updateCells(const QVector<int> &cells) {
+    int size = grid.size();
+    for (int index : cells) {
+        int i = index / size;
+        int j = index % size;
+        QLineEdit *cell = grid.at(i).at(j);
+        bool empty = liveGrid.cell(i, j) == 0;
+        int candidates = liveGrid.candidates(i, j);
+
+        // Style sheet is only replaced when highlight changes (expensive)
+        bool highlighted = liveGrid.isConflicting(i, j) || (empty && candidates == 0);
+        if (cell->property("highlighted").toBool() != highlighted) {
+            cell->setProperty("highlighted", highlighted);
+            cell->setStyleSheet(highlighted ? HighlightedCellStyle : CellStyle);
+        }
+
+        cell->setPlaceholderText(showCandidates && empty ? QString::number(candidates) : QString());
+    }
+}
+
+void MainWindow::showSolvability() {
+    int conflicts = liveGrid.conflictCount();
+    if (conflicts > 0) {
+        ui->statusBar->showMessage("Conflicting values in " + QString::number(conflicts) + " cells!");
+        return;
+    }
+
+    switch (liveGrid.solvability()) {
+    case LiveGrid::Solvable:
+        ui->statusBar->showMessage("Solvable");
+        break;
+    case LiveGrid::Unsolvable:
+        ui->statusBar->showMessage("No solution!");
+        break;
+    case LiveGrid::Unknown:
+        ui->statusBar->showMessage("Solvability unknown (search budget exceeded)");
+        break;
+    }
 }
 
 bool MainWindow::solveGrid(double &bench) {
     // Convert input data to primitive data
-    // Instantiate DLX solver
-    DLX dlx(UIGridToGrid());
+    // Instantiate solver of selected engine
+    QScopedPointer<Solver> solver(Solver::create(engine, grid.size()));
+    solver->setPropagation(propagation);
+    solver->reset(UIGridToGrid());
 
-    // Solve (convert problem to exact cover problem and solve with DLX)
+    // Solve (DLX: convert problem to exact cover problem and solve with DLX)
     auto benchStart = std::chrono::high_resolution_clock::now();
-    bool solved = dlx.solve();
+    bool solved = solver->solve();
     auto benchEnd = std::chrono::high_resolution_clock::now();
 
     if (solved) {
         // Apply to UI
-        gridToUIGrid(dlx.solution());
+        gridToUIGrid(solver->solution());
 
         bench = std::chrono::duration<double, std::milli>(benchEnd - benchStart).count();
     }
@@ -142,6 +219,36 @@ bool MainWindow::solveGrid(double &bench) {
     return solved;
 }
 
+void MainWindow::startSolve() {
+    activeSolver.reset(Solver::create(engine, grid.size()));
+    activeSolver->setPropagation(propagation);
+    activeSolver->setControl(&control);
+    activeSolver->reset(UIGridToGrid());
+
+    control.cancel = false;
+    control.nodes = 0;
+    setSolving(true);
+    solveTimer.start();
+    progressTimer.start();
+
+    // Worker thread only touches the solver, UI is updated from finished signal
+    Solver *solver = activeSolver.data();
+    solveWatcher.setFuture(QtConcurrent::run([solver]() {
+        return solver->solve();
+    }));
+}
+
+void MainWindow::setSolving(bool solving) {
+    ui->widget->setEnabled(!solving);
+    ui->spinBoxSize->setEnabled(!solving);
+    ui->comboBoxEngine->setEnabled(!solving);
+    ui->checkBoxPropagate->setEnabled(!solving);
+    ui->pushButtonImport->setEnabled(!solving);
+    ui->pushButtonSolve->setEnabled(!solving);
+    ui->pushButtonReset->setEnabled(!solving);
+    ui->pushButtonCancel->setEnabled(solving);
+}
+
 void MainWindow::runTests() {
     double benchSum = 0.0;
     bool allPassed = true;
@@ -154,20 +261,35 @@ void MainWindow::runTests() {
         resetGrid();
     }
 
-    // 16x16
-    qInfo() << "Running 16x16 Tests:";
-    generateGrid(16);
-    for (auto &test : Tests::s16x16) {
-        runTest(test, benchSum, allPassed);
+    // 16x16 cases take seconds each and would block start, they run in headless test runner (src/tests) only
+
+    // 9x9 with bitboard engine (not included in average time)
+    qInfo() << "Running 9x9 Tests (bitboard):";
+    double bitboardBenchSum = 0.0;
+    Solver::Engine selectedEngine = engine;
+    engine = Solver::Bitboard;
+    for (auto &test : Tests::s9x9) {
+        runTest(test, bitboardBenchSum, allPassed);
+        resetGrid();
+    }
+    engine = selectedEngine;
+
+    // 9x9 with propagation pre-pass (not included in average time)
+    qInfo() << "Running 9x9 Tests (propagation):";
+    double propagationBenchSum = 0.0;
+    propagation = true;
+    for (auto &test : Tests::s9x9) {
+        runTest(test, propagationBenchSum, allPassed);
         resetGrid();
     }
+    propagation = false;
 
     if (allPassed) {
         qInfo() << "All tests PASSED!";
     } else {
         qInfo() << "Some tests FAILED or gave WRONG results!";
     }
-    qInfo() << "Average time:" << benchSum / Tests::size() << "milliseconds";
+    qInfo() << "Average time:" << benchSum / Tests::s9x9.size() << "milliseconds";
 }
 
 void MainWindow::runTest(const Tests::Test &test, double &benchSum, bool &allPassed) {
@@ -181,7 +303,11 @@ void MainWindow::runTest(const Tests::Test &test, double &benchSum, bool &allPas
     if ((solved && !noSolution) || (!solved && noSolution)) {
         QString result = UIGridToStringGrid();
 
-        if (result == test.expectedResult || test.expectedResult == "any" || noSolution) {
+        // Engines other than DLX (or DLX after propagation) may find a different solution of non-unique puzzles
+        bool otherSolution = (engine != Solver::DancingLinks || propagation) && !noSolution
+                && Solver::isSolution(GridFormat::fromString(test.input), UIGridToGrid());
+
+        if (result == test.expectedResult || test.expectedResult == "any" || noSolution || otherSolution) {
             qInfo() << "- Passed:" << test.title << "(in" << bench << "milliseconds)";
         } else {
             qWarning() << "O Wrong:" << test.title << "(in" << bench << "milliseconds)";
@@ -210,42 +336,26 @@ Grid MainWindow::UIGridToGrid() const {
 }
 
 void MainWindow::gridToUIGrid(Grid sudoku) {
-    resetGrid();
+    for (auto &row : grid) {
+        for (auto &cell : row) {
+            cell->setText("");
+        }
+    }
 
     for (int i = 0; i < sudoku.size(); ++i) {
         for (int j = 0; j < sudoku.at(i).size(); ++j) {
             setCellValue(grid.at(i).at(j), sudoku.at(i).at(j));
         }
     }
+    syncLiveGrid();
 }
 
 void MainWindow::stringGridToUIGrid(QString gridStr) {
-    int i = 0;
-    int j = 0;
-    for (auto &valueStr : gridStr) {
-        setCellValue(grid.at(i).at(j), valueStr.digitValue());
-
-        if (++j >= grid.size()) {
-            j = 0;
-            ++i;
-        }
-    }
+    gridToUIGrid(GridFormat::fromString(gridStr));
 }
 
 QString MainWindow::UIGridToStringGrid() {
-    QString gridStr = "";
-    for (auto &row : grid) {
-        for (auto &cell : row) {
-            int value = cellValue(cell);
-            if (value < 1) {
-                gridStr.append(".");
-            } else {
-                gridStr.append(QString::number(value));
-            }
-        }
-    }
-
-    return gridStr;
+    return GridFormat::toString(UIGridToGrid());
 }
 
 // UI input getters/setters
@@ -266,32 +376,56 @@ void MainWindow::setCellValue(QLineEdit *cell, int value) {
 
 // Slots
 void MainWindow::onCellTextEdited(const QString &text) {
+    QLineEdit *cell = qobject_cast<QLineEdit *>(sender());
+
     // Manual low-bound validation (validator doesn't handle it)
     // Manual high-bound (below 9) validation (validator doesn't handle it)
-    int input = text.toInt();
-    if (input < 1 || input > grid.size()) {
-        int value;
-        for (auto &row : grid) {
-            for (auto &cell : row) {
-                value = cellValue(cell);
-                if (value == 0) {
-                    cell->setText("1");
-                }
-                if (value > grid.size()) {
-                    cell->setText(QString::number(grid.size()));
-                }
-            }
+    if (!text.isEmpty()) {
+        int input = text.toInt();
+        if (input < 1) {
+            cell->setText("1");
+        } else if (input > grid.size()) {
+            cell->setText(QString::number(grid.size()));
         }
     }
+
+    // Only the edited cell and cells sharing its row, column or region change
+    updateCells(liveGrid.setCell(cell->property("row").toInt(), cell->property("column").toInt(), cellValue(cell)));
+    showSolvability();
+}
+
+void MainWindow::onSolveProgress() {
+    ui->statusBar->showMessage(QString("Solving... %1 nodes, %2 seconds")
+                               .arg(control.nodes.load()).arg(solveTimer.elapsed() / 1000.0, 0, 'f', 1));
+}
+
+void MainWindow::onSolveFinished() {
+    progressTimer.stop();
+    double bench = solveTimer.nsecsElapsed() / 1e6;
+    quint64 nodes = activeSolver->nodesVisited();
+    bool solved = solveWatcher.result();
+
+    if (solved) {
+        gridToUIGrid(activeSolver->solution());
+        ui->statusBar->showMessage("Solved in " + QString::number(bench) + " milliseconds (" + QString::number(nodes) + " nodes)!");
+        qInfo() << "Solution:" << UIGridToStringGrid();
+    } else if (activeSolver->result() == Solver::Cancelled) {
+        ui->statusBar->showMessage("Cancelled after " + QString::number(bench) + " milliseconds (" + QString::number(nodes) + " nodes)!");
+    } else {
+        ui->statusBar->showMessage("No solution!");
+    }
+
+    activeSolver.reset();
+    setSolving(false);
 }
 
 void MainWindow::on_spinBoxSize_valueChanged(int size) {
     // Set value by supported steps (varied)
     if (size < grid.size()) {
-        QMap<int, int> steps = { {25, 16}, {16, 9}, {9, 4} };
+        QMap<int, int> steps = { {64, 49}, {49, 36}, {36, 25}, {25, 16}, {16, 9}, {9, 4} };
         size = steps[size + 1];
     } else if (size > grid.size()) {
-        QMap<int, int> steps = { {4, 9}, {9, 16}, {16, 25} };
+        QMap<int, int> steps = { {4, 9}, {9, 16}, {16, 25}, {25, 36}, {36, 49}, {49, 64} };
         size = steps[size - 1];
     }
     ui->spinBoxSize->blockSignals(true);
@@ -308,23 +442,37 @@ void MainWindow::on_spinBoxSize_valueChanged(int size) {
     }
 }
 
+void MainWindow::on_comboBoxEngine_currentIndexChanged(int index) {
+    engine = static_cast<Solver::Engine>(index);
+
+    if (!Solver::supports(engine, grid.size())) {
+        ui->statusBar->showMessage("Engine does not support " + QString::number(grid.size()) + "x" + QString::number(grid.size()) + ", using DLX!");
+    }
+}
+
+void MainWindow::on_checkBoxPropagate_toggled(bool checked) {
+    propagation = checked;
+}
+
+void MainWindow::on_checkBoxCandidates_toggled(bool checked) {
+    showCandidates = checked;
+    syncLiveGrid();
+}
+
 void MainWindow::on_pushButtonImport_clicked() {
     bool ok;
-    QString text = QInputDialog::getText(this, "Sudoku Import", "Input Sudoku problem in format: 53.2..4...", QLineEdit::Normal, nullptr, &ok);
+    QString text = QInputDialog::getText(this, "Sudoku Import", "Input Sudoku problem in format: 53.2..4... (values above 9 as A-Z, a-z) or 5,3,.,2,...",
+                                         QLineEdit::Normal, nullptr, &ok);
     if (ok && !text.isEmpty()) {
-        bool generated = true;
-        if (text.size() != grid.size() * grid.size()) {
-            double sizeSqrt = sqrt(text.size());
-            double intpart;
-            if (modf(sizeSqrt, &intpart) == 0.0) {
-                generated = generateGrid(static_cast<int>(sqrt(text.size())));
-            } else {
-                generated = false;
-            }
+        // Size taken from number of cells
+        Grid sudoku = GridFormat::fromString(text);
+        bool generated = !sudoku.isEmpty();
+        if (generated && sudoku.size() != grid.size()) {
+            generated = generateGrid(sudoku.size());
         }
 
         if (generated) {
-            stringGridToUIGrid(text);
+            gridToUIGrid(sudoku);
             ui->statusBar->showMessage("Imported!");
         } else {
             ui->statusBar->showMessage("Invalid grid size! Only NxN grids supported.");
@@ -335,17 +483,16 @@ void MainWindow::on_pushButtonImport_clicked() {
 }
 
 void MainWindow::on_pushButtonSolve_clicked() {
-    double bench;
-    bool solved = solveGrid(bench);
-
-    if (solved) {
-        ui->statusBar->showMessage("Solved in " + QString::number(bench) + " milliseconds!");
-        qInfo() << "Solution:" << UIGridToStringGrid();
-    } else {
-        ui->statusBar->showMessage("No solution!");
+    if (!activeSolver) {
+        startSolve();
     }
 }
 
+void MainWindow::on_pushButtonCancel_clicked() {
+    control.cancel = true;
+    ui->statusBar->showMessage("Cancelling...");
+}
+
 void MainWindow::on_pushButtonReset_clicked() {
     resetGrid();
 }
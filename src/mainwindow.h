@@ -2,10 +2,16 @@
 
 #include <QMainWindow>
 #include <QLineEdit>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QScopedPointer>
+#include <QTimer>
 
 #include <QDebug>
 
-#include "dlx.h"
+#include "solver.h"
+#include "gridformat.h"
+#include "livegrid.h"
 #include "tests.h"
 
 using UIGridRow = QList<QLineEdit *>;
@@ -26,12 +32,35 @@ private:
     Ui::MainWindow *ui;
 
     UIGrid grid;
+    Solver::Engine engine; // Falls back to DLX for grid sizes not supported by engine
+    bool propagation; // Constraint propagation pre-pass before search
+    bool showCandidates; // Number of candidates shown in empty cells
+
+    // Solver state of edited grid, updated cell by cell (conflicts, candidates, solvability)
+    LiveGrid liveGrid;
+
+    // Background solving (Solve button), UI stays responsive and search can be cancelled
+    QScopedPointer<Solver> activeSolver; // Solver running on worker thread (null if idle)
+    Solver::Control control; // Cancel request and live progress of active solver
+    QFutureWatcher<bool> solveWatcher;
+    QTimer progressTimer; // Refreshes progress in status bar
+    QElapsedTimer solveTimer;
 
     bool generateGrid(int size);
     void deleteGrid();
     void resetGrid();
-    // Solves current grid and saves benchmark in millseconds
+    // Loads all cells into live solver state (after changing many cells at once)
+    void syncLiveGrid();
+    // Refreshes conflict highlight and candidate count of given cells (row-major indices)
+    void updateCells(const QVector<int> &cells);
+    // Shows conflicts or solvability of current grid in status bar
+    void showSolvability();
+    // Solves current grid and saves benchmark in millseconds (blocking, used by tests)
     bool solveGrid(double &bench);
+    // Starts solving current grid on worker thread
+    void startSolve();
+    // Enables cancel and disables all other inputs while solving (and the reverse)
+    void setSolving(bool solving);
     void runTests();
     void runTest(const Tests::Test &test, double &benchSum, bool &allPassed);
 
@@ -40,9 +69,9 @@ private:
     Grid UIGridToGrid() const;
     // Applies int grid (DLX) to UI grid
     void gridToUIGrid(Grid sudoku);
-    // Applies string grid (53.2..4...) to UI grid
+    // Applies string grid (53.2..4... or 5,3,.,2,...) to UI grid
     void stringGridToUIGrid(QString gridStr);
-    // Converts UI grid to string grid (53.2..4...)
+    // Converts UI grid to string grid (53.2..4..., or 5,3,.,2,... if too large for dotted string format)
     QString UIGridToStringGrid();
 
     // UI input getters/setters
@@ -51,8 +80,14 @@ private:
 
 private slots:
     void onCellTextEdited(const QString &text);
+    void onSolveProgress();
+    void onSolveFinished();
     void on_spinBoxSize_valueChanged(int size);
+    void on_comboBoxEngine_currentIndexChanged(int index);
+    void on_checkBoxPropagate_toggled(bool checked);
+    void on_checkBoxCandidates_toggled(bool checked);
     void on_pushButtonImport_clicked();
     void on_pushButtonSolve_clicked();
+    void on_pushButtonCancel_clicked();
     void on_pushButtonReset_clicked();
 };
@@ -0,0 +1,226 @@
+#include "puzzlefile.h"
+#include "gridformat.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+const char PuzzleFile::Magic[4] = {'S', 'D', 'L', 'X'};
+const int PuzzleFile::Version = 1;
+const int PuzzleFile::HeaderSize = 16;
+const int PuzzleFile::MaxSize = GridFormat::MaxSize;
+
+// Puzzle View
+PuzzleView::PuzzleView(const uchar *data, int size, int bits) : data(data), gridSize(size), bits(bits) {}
+
+int PuzzleView::size() const {
+    return gridSize;
+}
+
+int PuzzleView::cell(int i) const {
+    // Cell may span two bytes (bits per cell is at most 8)
+    int bit = i * bits;
+    const uchar *byte = data + (bit >> 3);
+    int shift = bit & 7;
+    int value = byte[0] >> shift;
+    if (shift + bits > 8) {
+        value |= byte[1] << (8 - shift);
+    }
+    return value & ((1 << bits) - 1);
+}
+
+void PuzzleView::unpack(int *cells) const {
+    int count = gridSize * gridSize;
+    for (int i = 0; i < count; ++i) {
+        int value = cell(i);
+        cells[i] = value > 0 ? value : -1;
+    }
+}
+
+Grid PuzzleView::toGrid() const {
+    Grid sudoku;
+    sudoku.reserve(gridSize);
+    for (int i = 0; i < gridSize; ++i) {
+        GridRow row;
+        row.reserve(gridSize);
+        for (int j = 0; j < gridSize; ++j) {
+            int value = cell(i * gridSize + j);
+            row.append(value > 0 ? value : -1);
+        }
+        sudoku.append(row);
+    }
+    return sudoku;
+}
+
+// Puzzle File
+PuzzleFile::PuzzleFile() : data(nullptr), gridSize(0), bits(0), bytes(0), puzzleCount(0) {}
+
+bool PuzzleFile::open(const QString &fileName) {
+    close();
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HeaderSize) {
+        close();
+        return false;
+    }
+
+    data = file.map(0, file.size());
+    if (data == nullptr || memcmp(data, Magic, sizeof(Magic)) != 0 || data[4] != Version) {
+        close();
+        return false;
+    }
+
+    bits = data[5];
+    gridSize = qFromLittleEndian<quint16>(data + 6);
+    puzzleCount = static_cast<qint64>(qFromLittleEndian<quint64>(data + 8));
+
+    // Exit if not supported NxN size (solvers index regions by it) or values 0 to N do not fit a single byte
+    if (!GridFormat::isValidSize(gridSize) || gridSize > MaxSize) {
+        close();
+        return false;
+    }
+    bytes = puzzleBytes(gridSize);
+
+    // Validate header against file contents
+    if (bits != bitsPerCell(gridSize) || puzzleCount < 0 || (file.size() - HeaderSize) / bytes < puzzleCount) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void PuzzleFile::close() {
+    if (data != nullptr) {
+        file.unmap(const_cast<uchar *>(data));
+        data = nullptr;
+    }
+    file.close();
+
+    gridSize = 0;
+    bits = 0;
+    bytes = 0;
+    puzzleCount = 0;
+}
+
+bool PuzzleFile::isPuzzleFile(const QString &fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(sizeof(Magic)) == QByteArray(Magic, sizeof(Magic));
+}
+
+int PuzzleFile::size() const {
+    return gridSize;
+}
+
+qint64 PuzzleFile::count() const {
+    return puzzleCount;
+}
+
+PuzzleView PuzzleFile::puzzle(qint64 i) const {
+    return PuzzleView(data + HeaderSize + i * bytes, gridSize, bits);
+}
+
+int PuzzleFile::bitsPerCell(int size) {
+    int bits = 1;
+    while ((1 << bits) <= size) {
+        ++bits;
+    }
+    return bits;
+}
+
+int PuzzleFile::puzzleBytes(int size) {
+    return (size * size * bitsPerCell(size) + 7) / 8;
+}
+
+// Puzzle Writer
+PuzzleWriter::PuzzleWriter() : gridSize(0), bits(0), puzzleCount(0) {}
+
+PuzzleWriter::~PuzzleWriter() {
+    close();
+}
+
+bool PuzzleWriter::open(const QString &fileName, int size) {
+    close();
+
+    // Exit if not supported NxN size or values 0 to N do not fit a single byte
+    if (!GridFormat::isValidSize(size) || size > PuzzleFile::MaxSize) {
+        return false;
+    }
+
+    gridSize = size;
+    bits = PuzzleFile::bitsPerCell(size);
+    buffer.resize(PuzzleFile::puzzleBytes(size));
+    puzzleCount = 0;
+
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    // Count is rewritten on close
+    writeHeader();
+    return true;
+}
+
+void PuzzleWriter::close() {
+    if (file.isOpen()) {
+        file.seek(0);
+        writeHeader();
+        file.close();
+    }
+}
+
+bool PuzzleWriter::write(const Grid &sudoku) {
+    if (sudoku.size() != gridSize) {
+        return false;
+    }
+
+    buffer.fill(0);
+    uchar *data = reinterpret_cast<uchar *>(buffer.data());
+
+    for (int i = 0; i < gridSize; ++i) {
+        if (sudoku.at(i).size() != gridSize) {
+            return false;
+        }
+
+        for (int j = 0; j < gridSize; ++j) {
+            int value = qMax(0, sudoku.at(i).at(j));
+            if (value > gridSize) {
+                return false;
+            }
+
+            // Cell may span two bytes (bits per cell is at most 8)
+            int bit = (i * gridSize + j) * bits;
+            uchar *byte = data + (bit >> 3);
+            int shift = bit & 7;
+            byte[0] |= static_cast<uchar>(value << shift);
+            if (shift + bits > 8) {
+                byte[1] |= static_cast<uchar>(value >> (8 - shift));
+            }
+        }
+    }
+
+    if (file.write(buffer) != buffer.size()) {
+        return false;
+    }
+    ++puzzleCount;
+    return true;
+}
+
+qint64 PuzzleWriter::count() const {
+    return puzzleCount;
+}
+
+void PuzzleWriter::writeHeader() {
+    QByteArray header(PuzzleFile::HeaderSize, 0);
+    uchar *data = reinterpret_cast<uchar *>(header.data());
+    memcpy(data, PuzzleFile::Magic, sizeof(PuzzleFile::Magic));
+    data[4] = static_cast<uchar>(PuzzleFile::Version);
+    data[5] = static_cast<uchar>(bits);
+    qToLittleEndian<quint16>(static_cast<quint16>(gridSize), data + 6);
+    qToLittleEndian<quint64>(static_cast<quint64>(puzzleCount), data + 8);
+    file.write(header);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+
+#include "dlx.h"
+
+// Packed binary puzzle format
+// Header (16 bytes, little endian):
+// - Magic "SDLX" (4 bytes)
+// - Version (1 byte)
+// - Bits per cell (1 byte, enough to hold values 0 to N)
+// - Grid size N (2 bytes)
+// - Puzzle count (8 bytes)
+// Puzzles: N * N cells (row-major, 0 if empty) packed least significant bit first, each puzzle padded to whole bytes
+
+// Read-only view of a single packed puzzle (points into mapped file, no copy)
+class PuzzleView {
+public:
+    PuzzleView(const uchar *data, int size, int bits);
+
+    int size() const;
+    // Value of i-th cell (row-major), 0 if empty
+    int cell(int i) const;
+    // Unpacks all cells (row-major) into given array of at least size * size values, empty cells are -1
+    void unpack(int *cells) const;
+    // Converts to int grid (DLX)
+    Grid toGrid() const;
+
+private:
+    const uchar *data;
+    int gridSize;
+    int bits;
+};
+
+// Memory-mapped reader of packed binary puzzle files
+class PuzzleFile {
+public:
+    static const char Magic[4];
+    static const int Version;
+    static const int HeaderSize;
+    static const int MaxSize; // Largest grid size supported by solvers (values fit a single byte per cell)
+
+    PuzzleFile();
+
+    // Maps file into memory and validates header (supported NxN size, bits per cell, puzzle count), returns false on failure
+    bool open(const QString &fileName);
+    void close();
+    // Checks if file starts with packed binary format magic
+    static bool isPuzzleFile(const QString &fileName);
+
+    int size() const;
+    qint64 count() const;
+    PuzzleView puzzle(qint64 i) const;
+
+    // Number of bits needed per cell for given grid size (values 0 to N)
+    static int bitsPerCell(int size);
+    // Number of bytes per puzzle for given grid size
+    static int puzzleBytes(int size);
+
+private:
+    QFile file;
+    const uchar *data;
+    int gridSize;
+    int bits;
+    int bytes;
+    qint64 puzzleCount;
+};
+
+// Writer of packed binary puzzle files
+class PuzzleWriter {
+public:
+    PuzzleWriter();
+    ~PuzzleWriter();
+
+    // Creates file for puzzles of given size, returns false on failure or if size is not supported NxN size
+    bool open(const QString &fileName, int size);
+    // Finalizes header with puzzle count
+    void close();
+
+    // Appends puzzle, returns false if grid size does not match or value is not representable
+    bool write(const Grid &sudoku);
+
+    qint64 count() const;
+
+private:
+    QFile file;
+    int gridSize;
+    int bits;
+    QByteArray buffer;
+    qint64 puzzleCount;
+
+    void writeHeader();
+};
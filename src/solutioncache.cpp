@@ -0,0 +1,114 @@
+#include "solutioncache.h"
+#include "gridformat.h"
+
+#include <QStringList>
+#include <QTextStream>
+
+const int SolutionCache::DefaultCapacity = 100000;
+
+SolutionCache::SolutionCache(int capacity) : entries(qMax(1, capacity)), hitCount(0), missCount(0) {}
+
+bool SolutionCache::open(const QString &fileName) {
+    QMutexLocker locker(&mutex);
+    file.close();
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Append | QIODevice::Text)) {
+        return false;
+    }
+
+    // Load entries in file order, so the most recently written ones survive if file holds more than capacity
+    file.seek(0);
+    QTextStream in(&file);
+    QString line;
+    while (in.readLineInto(&line)) {
+        QStringList fields = line.trimmed().split(' ');
+        if (fields.size() != 2) {
+            continue;
+        }
+
+        Grid puzzle = GridFormat::fromString(fields.at(0));
+        Grid solution = fields.at(1) == Solver::resultName(Solver::NoSolution) ? Grid() : GridFormat::fromString(fields.at(1));
+        if (puzzle.isEmpty() || (!solution.isEmpty() && solution.size() != puzzle.size())) {
+            continue;
+        }
+        store(CanonicalForm::pack(puzzle), solution.isEmpty() ? QByteArray() : CanonicalForm::pack(solution));
+    }
+    file.seek(file.size());
+    return true;
+}
+
+void SolutionCache::close() {
+    QMutexLocker locker(&mutex);
+    file.close();
+}
+
+bool SolutionCache::find(const CanonicalForm &form, Solver::Result &result, Grid &solution) {
+    if (!form.isValid()) {
+        return false;
+    }
+
+    QByteArray key = form.key();
+    QMutexLocker locker(&mutex);
+    Entry *entry = entries.object(key);
+    if (!entry) {
+        ++missCount;
+        return false;
+    }
+
+    ++hitCount;
+    QByteArray packed = entry->solution;
+    locker.unlock();
+
+    if (packed.isEmpty()) {
+        result = Solver::NoSolution;
+        solution = Grid();
+    } else {
+        result = Solver::Solved;
+        solution = form.toOriginal(CanonicalForm::unpack(packed));
+    }
+    return true;
+}
+
+void SolutionCache::insert(const CanonicalForm &form, Solver::Result result, const Grid &solution) {
+    if (!form.isValid() || (result != Solver::Solved && result != Solver::NoSolution)) {
+        return;
+    }
+
+    Grid canonical = result == Solver::Solved ? form.toCanonical(solution) : Grid();
+    QByteArray key = form.key();
+    QByteArray packed = canonical.isEmpty() ? QByteArray() : CanonicalForm::pack(canonical);
+
+    QMutexLocker locker(&mutex);
+    if (entries.contains(key)) {
+        return;
+    }
+    store(key, packed);
+
+    if (file.isOpen()) {
+        QTextStream out(&file);
+        out << GridFormat::toString(form.grid()) << ' '
+            << (canonical.isEmpty() ? Solver::resultName(Solver::NoSolution) : GridFormat::toString(canonical)) << '\n';
+    }
+}
+
+int SolutionCache::size() const {
+    QMutexLocker locker(&mutex);
+    return entries.size();
+}
+
+quint64 SolutionCache::hits() const {
+    QMutexLocker locker(&mutex);
+    return hitCount;
+}
+
+quint64 SolutionCache::misses() const {
+    QMutexLocker locker(&mutex);
+    return missCount;
+}
+
+// Helpers
+void SolutionCache::store(const QByteArray &key, const QByteArray &solution) {
+    Entry *entry = new Entry;
+    entry->solution = solution;
+    entries.insert(key, entry); // Cache takes ownership
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+
+#include "canonicalform.h"
+
+// Cache of solve results keyed by canonical form of puzzles (thread-safe), least recently used entries are evicted
+// Transformed variants of a cached puzzle (relabeled digits, permuted lines, transposed) hit the same entry
+// Optional cache file keeps entries between runs, one per line: canonical puzzle and its solution or 'none'
+class SolutionCache {
+public:
+    static const int DefaultCapacity;
+
+    explicit SolutionCache(int capacity = DefaultCapacity);
+
+    // Loads entries of cache file (created if missing) and appends every new entry to it, returns false on failure
+    bool open(const QString &fileName);
+    void close();
+
+    // Looks up puzzle, returns false if not cached
+    // Result is Solved or NoSolution, solution is mapped back to layout and digits of the puzzle
+    bool find(const CanonicalForm &form, Solver::Result &result, Grid &solution);
+    // Stores result of puzzle, only definite results (Solved with its solution or NoSolution) are kept
+    void insert(const CanonicalForm &form, Solver::Result result, const Grid &solution);
+
+    int size() const;
+    quint64 hits() const;
+    quint64 misses() const;
+
+private:
+    // Packed canonical solution, empty if puzzle has no solution
+    struct Entry {
+        QByteArray solution;
+    };
+
+    mutable QMutex mutex;
+    QCache<QByteArray, Entry> entries; // Keyed by packed canonical puzzle
+    QFile file;
+    quint64 hitCount;
+    quint64 missCount;
+
+    // Stores entry without writing it to cache file
+    void store(const QByteArray &key, const QByteArray &solution);
+};
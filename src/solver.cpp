@@ -0,0 +1,94 @@
+#include "solver.h"
+#include "dlx.h"
+#include "bitboardsolver.h"
+
+#include <cmath>
+
+Solver::~Solver() {}
+
+void Solver::setPropagation(bool) {}
+
+void Solver::setControl(Control *) {}
+
+Solver *Solver::create(Engine engine, int size) {
+    if (!supports(engine, size)) {
+        engine = DancingLinks;
+    }
+
+    switch (engine) {
+    case Bitboard:
+        return new BitboardSolver();
+    case DancingLinks:
+    default:
+        return new DLX(Grid());
+    }
+}
+
+bool Solver::supports(Engine engine, int size) {
+    switch (engine) {
+    case Bitboard:
+        return size == BitboardSolver::Size;
+    case DancingLinks:
+    default:
+        return true;
+    }
+}
+
+QString Solver::engineName(Engine engine) {
+    switch (engine) {
+    case Bitboard:
+        return "bitboard";
+    case DancingLinks:
+    default:
+        return "dlx";
+    }
+}
+
+QString Solver::resultName(Result result) {
+    switch (result) {
+    case Solved:
+        return "solved";
+    case NoSolution:
+        return "none";
+    case BudgetExhausted:
+        return "exhausted";
+    case Cancelled:
+    default:
+        return "cancelled";
+    }
+}
+
+bool Solver::isSolution(const Grid &sudoku, const Grid &solution) {
+    int size = solution.size();
+    int sizeSqrt = static_cast<int>(std::sqrt(size));
+    if (sudoku.size() != size || sizeSqrt * sizeSqrt != size) {
+        return false;
+    }
+
+    // Seen values per row, column and region (value - 1 offset)
+    QVector<bool> seen(3 * size * size, false);
+    for (int i = 0; i < size; ++i) {
+        if (sudoku.at(i).size() != size || solution.at(i).size() != size) {
+            return false;
+        }
+
+        for (int j = 0; j < size; ++j) {
+            int value = solution.at(i).at(j);
+            int given = sudoku.at(i).at(j);
+            if (value < 1 || value > size || (given > 0 && given != value)) {
+                return false;
+            }
+
+            int region = (i / sizeSqrt) * sizeSqrt + j / sizeSqrt;
+            int slots[3] = {i * size, (size + j) * size, (2 * size + region) * size};
+            for (int slot : slots) {
+                if (seen.at(slot + value - 1)) {
+                    return false;
+                }
+                seen[slot + value - 1] = true;
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+
+// Use QList::at() wherever possible, as it is guaranteed constant time (QList::operator[] is not)
+
+using GridRow = QList<int>;
+using Grid = QList<GridRow>;
+
+class PuzzleView;
+
+// Common interface of solving engines
+class Solver {
+public:
+    enum Engine {
+        DancingLinks, // Any NxN size
+        Bitboard // 9x9 only
+    };
+
+    // Outcome of last solve
+    enum Result {
+        Solved,
+        NoSolution, // Search exhausted or values conflicting
+        BudgetExhausted, // Node or time budget ran out first (search statistics and nodes cover the searched part)
+        Cancelled // Cancelled through control
+    };
+
+    // Limits of a single solve (0 for no limit)
+    struct Budget {
+        quint64 nodes = 0; // Maximum search nodes visited (exact)
+        qint64 milliseconds = 0; // Maximum wall time of search (checked every few thousand nodes)
+    };
+
+    // Duration of solve phases in nanoseconds
+    struct PhaseTimes {
+        qint64 propagate = 0; // Constraint propagation pre-pass (DLX only, if enabled)
+        qint64 build = 0; // Preparing solver structures (DLX: copying prebuilt links, includes building them on first use of grid size)
+        qint64 cover = 0; // Applying values already present in the grid
+        qint64 search = 0; // Search (solve() only)
+    };
+
+    // Shared between a thread running the search and its observers (e.g. GUI thread)
+    // Search checks it periodically (every few thousand nodes), not at every node
+    struct Control {
+        std::atomic<bool> cancel{false}; // Stops search when set (solve returns false)
+        std::atomic<quint64> nodes{0}; // Search nodes visited so far in current solve
+    };
+
+    virtual ~Solver();
+
+    // Replaces the grid to solve
+    virtual void reset(Grid sudoku) = 0;
+    // Replaces the grid to solve with a packed puzzle, unpacked directly into solver (no intermediate grid)
+    virtual void reset(const PuzzleView &puzzle) = 0;
+
+    // Returns true only if solved, result() tells why not
+    virtual bool solve() = 0;
+    virtual Grid solution() const = 0;
+    virtual Result result() const = 0;
+    // Search nodes visited in last solve
+    virtual quint64 nodesVisited() const = 0;
+    // Phase durations of last solve
+    virtual const PhaseTimes &phaseTimes() const = 0;
+    // Enables constraint propagation pre-pass (naked and hidden singles) before search
+    // Engines that already propagate during search ignore it
+    virtual void setPropagation(bool enabled);
+    // Attaches control to all following solves (nullptr to detach), must outlive the searches
+    virtual void setControl(Control *control);
+    // Limits all following solves
+    virtual void setBudget(const Budget &budget) = 0;
+
+    // Creates solver with given engine for grid size (caller takes ownership)
+    // Falls back to dancing links if engine does not support grid size
+    static Solver *create(Engine engine, int size);
+    // Checks if engine supports grid size
+    static bool supports(Engine engine, int size);
+    static QString engineName(Engine engine);
+    static QString resultName(Result result);
+
+    // Checks if solution is a completed valid grid that keeps all values already present in sudoku
+    static bool isSolution(const Grid &sudoku, const Grid &solution);
+};
@@ -179,34 +179,31 @@ namespace Tests {
 
     static const QList<Test> s16x16 = {
         // Test cases from http://magictour.free.fr/top44
+        // Values 10 to 16 are letters A to G (dotted string format)
         {
             "Hard 1",
             ".63B.EC..A..8....847..A6..B....9.....81.D.G...7E.......7..98...CF.D.....AC..2.......D.....E1..5.CE......6...GF.31A.9...B8G7.4..D2.E...45....69.F.7......E..A...5..94..6......D.....63..F79.5...A....E6.D.1...2.8...3G.FA56.......D.C...9...B1.6..2..B.5C9.....34",
-            "10631911121314721585416138475101461121116153299125215811634613101471114161511432710598126113346512711101513149281618152136934121116114751071416121281561054111393111109135161483724121562313147164511811069121515712161019821413634115519411136216153127108141110863141512794516113249141516673131121152108161313241011568791514121251181415139421031166762710812519161514131134"
+            "D63B9ECG4A1785F258472FA6C3BED1G9A9C25813DFG6B47EEFG14BD7259836ACFBD86GE4AC532791347GDC92FBE1A856CE25A7816D49GFB31A69F53B8G724CED23EA7D45B8CG691FG7FD19B8E46AC325B594CA6E123F7D8G8C1632GF79D5EB4A9GBFE67D31A452C87183G4FA562C9EDB4D5C8329GEFB1A6762AEB15C978DFG34"
         },
         {
             "Hard 2",
             ".B.293.F..C.......7.B..5......C..9..C...247.F...EF..6....9B.3D..F...58G...........B3......2F1.7.....E...1.8..C.D...1...3.D...G..4.6...2.3..9A.8.12..G.86.F......A7....C...419.G......E..5....7437..........B.3.C.8...DF......E96.E.6...9......D8..G..7..C..4...A",
-            "61529310811121314415167144781513165101362911123916151112141247861013510111213627416951538141121011758116415931362148164310691412521311171596214131115711081651234513151241237614118161094561171621231415910181312394148613711101251516137141231051581641926111615810191311526121474371494165111368121531210118101614132151312574962316121549141110716135815121358761093164111412"
+            "GB5293DF61CE48A76374B2A5DGF8E9C1D91ACGE82473F56BEF8C6147A9B53D2GFADE58G1476CB2398GB3DC649E2F1A759547EAB2138G6CFDC621F973BD5A8GE44D6G752B3CE9A18F1239G4867FADCB5EA7E53FCD8B4196G2BCF81E9A52G6D743749FA65GE8DB231C38AB4DFCG5127E965EC62B19FA37G4D821GD873EC6945FBA"
         },
         {
             "Hard 3",
             "4...C7B...86....8.7G.A..E3..4D..6....9....1..A3.9......D...4..5FG..A.8F..B4.3....D3...AG..F..17...6..E....2.....7....B....5.E4...1E2A..4D.....8.C.5......A.76..D........329.F....8....65.....B.3.......E91.......B..G.8...A...C.5...F.....3C79E...GD.21.....5368",
-            "41011512732139861141516812711513516231114469106132144910815511611123791615361114171012481352159161328116127413510142538161441210111591317614610135715141623128119711141213910685131642153113214101541161612978510155169123841476111213146127816131132951510411189471265115131021614316386541279110214151311127193158135146111021645210151161614413387911213144111021916127155368"
+            "4ADFC7B325861G9E827G1A5FE3C94DB66EB58942FG1DCA37931C6GEDA7B4285FG5CA98F17B4E36D22D3E45AG69F8B17C146B7E3CGD2A85F979F8DB261C53E4GA31E2ACG4DF6B9785CF54319B8AG76E2DBGA6ED783295FC14D8972F65C4E1GBA3F78356CE91DGA24BEB49G38756A2DFC15621F4DAB83C79EGACGDB2194E7F5368"
         },
         {
             "Hard 4",
             ".G4..........B8...E.2.8.1..7..5......B.F26..9..3B..DA....F.9..E.2....A1.....786G561.C..4...32......C......9F.5A.....G6.......9..F...51G..2......D8C....9..E..67..E....F.AD4.C..B...7...D8.......C..E69.B....51...98...E...3....D..G.735...A4F.....35...A...2..4.",
-            "10114612793131451516281912133216815141076115141614715105412681191213382511113146312169104157231610915113451214786115619168104117133214121541511814212761691035113713121436115151284916103169125178102116151314415821141039161314121675145613151216273418101191410713116148915512321612101546921614117135138698214131151531614710121311416735101286411159211735814151291012131646"
+            "3G4F9571CEDA6B829CE62G8314B7DF5A817AEBDF265G94C3B52DA46C3F89G7E123D9FA154BCE786G5618CE947AG32DBFG7BC3D28619F45AEEAF4G6B7D528391CFB6351GE927C8AD4D8CG42A9F3EB16751E9287F6AD45C3GBA457BC3D8G61E2F9C2AE694BG8FD5137498B1FEG5736AC2D6DG17352BCA4FE987F35D8CAE912BG46"
         },
         {
             "Hard 5",
             ".EB....A..F18..5..A97........3C..5G...43..B....EC.1....F.A38....26.....1...4.F..5....2.....9...G.3.8.G.6C..F......E...D...5.B.A.E...B8...7.C.4...D.....4....35..B.5F.6.......C.749..A7.5.D.2.GF.8.7...E.6.G..A...G2B5.......4.9.....6....81.7..3.....C..2B.A..GD",
-            "37101121261314941815165151316975810116212134141458219431016131511761212416151116147538910132269781451151116412133105111316321578101296114410312841696113147521115114154121013113256169786231138141557111610412978141011112491561335216161251396102418314111574911151673512141021381681573141311264952161011111214537816121510469139104126152161381117145313166510411923714151281"
+            "DEB329CA7GF1864568A97E1B452DG3CFF5G28D439CB6A17EC714G56FEA382DB926DG9A51BE74CF385BFA428C31D967EG7348EGB6C2AFD95191ECF3D7865GB2A4E231B8FG576C94DAGD87C194AFEB3562BA5FD62EG4931C8749C6A7351D82EGFB847D3BE269G5FA1C1G2B5FA8D3C74E96AC9564GDF81E7B233F6E1C792B4A58GD"
         },
     };
-
-    inline int size() {
-        return s9x9.size() + s16x16.size();
-    }
 }
@@ -0,0 +1,296 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QScopedPointer>
+#include <QSet>
+#include <QtEndian>
+
+#include <QDebug>
+
+#include "dlx.h"
+#include "gridformat.h"
+#include "puzzlefile.h"
+#include "solver.h"
+#include "tests.h"
+
+#include <cstring>
+
+// Number of failed checks over all sections
+static int failures = 0;
+
+static void check(bool passed, const QString &title) {
+    if (passed) {
+        qInfo().noquote() << "- Passed:" << title;
+    } else {
+        qCritical().noquote() << "X Failed:" << title;
+        ++failures;
+    }
+}
+
+// Solves in-code test cases with a fresh solver each and compares with expected results (same rules as GUI)
+static void runTestCases(const QString &name, const QList<Tests::Test> &tests, Solver::Engine engine, bool propagation) {
+    qInfo().noquote() << "Running" << name << "Tests:";
+
+    for (auto &test : tests) {
+        Grid sudoku = GridFormat::fromString(test.input);
+        QScopedPointer<Solver> solver(Solver::create(engine, sudoku.size()));
+        solver->setPropagation(propagation);
+
+        QElapsedTimer timer;
+        timer.start();
+        solver->reset(sudoku);
+        bool solved = solver->solve();
+        qint64 elapsed = timer.elapsed();
+
+        bool noSolution = test.expectedResult == "none";
+        bool passed = solved != noSolution;
+        if (solved && !noSolution) {
+            // Engines other than DLX (or DLX after propagation) may find a different solution of non-unique puzzles
+            bool otherSolution = (engine != Solver::DancingLinks || propagation) && Solver::isSolution(sudoku, solver->solution());
+            passed = GridFormat::toString(solver->solution()) == test.expectedResult || test.expectedResult == "any" || otherSolution;
+        }
+        check(passed, test.title + " (in " + QString::number(elapsed) + " milliseconds)");
+    }
+}
+
+// Budgeted parallel search either finds the solution serial search finds first (expected result)
+// or runs out of budget after searching at least a full thread share of it, never more than all of it
+static void runParallelBudgetTests(const QString &name, const QList<Tests::Test> &tests) {
+    const int threads = 4;
+    qInfo().noquote() << "Running" << name << "Parallel Budget Tests:";
+
+    for (auto &test : tests) {
+        if (test.expectedResult == "any" || test.expectedResult == "none") {
+            continue;
+        }
+
+        Grid sudoku = GridFormat::fromString(test.input);
+        for (quint64 nodes : {1000, 20000, 200000}) {
+            DLX dlx(sudoku);
+            Solver::Budget budget;
+            budget.nodes = nodes;
+            dlx.setBudget(budget);
+            bool solved = dlx.solveParallel(threads);
+
+            bool passed;
+            if (solved) {
+                // Puzzles with several solutions may be solved in a different subtree first
+                passed = GridFormat::toString(dlx.solution()) == test.expectedResult
+                        || (test.title.startsWith("Not Unique") && Solver::isSolution(sudoku, dlx.solution()));
+            } else {
+                passed = dlx.result() == Solver::BudgetExhausted
+                        && dlx.nodesVisited() >= nodes / threads && dlx.nodesVisited() <= nodes;
+            }
+            check(passed, test.title + " (budget " + QString::number(nodes) + " nodes, "
+                  + Solver::resultName(dlx.result()) + " after " + QString::number(dlx.nodesVisited()) + " nodes)");
+        }
+    }
+}
+
+// Budgeted parallel count of empty grid, whose subtrees are all larger than a thread share of budget,
+// so every thread searches exactly its share
+static void runParallelBudgetCount(int size) {
+    const int threads = 4;
+    const quint64 nodes = 100000;
+    qInfo().noquote() << "Running" << QString::number(size) + "x" + QString::number(size) << "Parallel Budget Count:";
+
+    ExactCover exactCover(*DLX::exactCoverTemplate(size));
+    exactCover.setBudget(nodes, 0);
+    exactCover.countSolutionsParallel(0, threads);
+    check(exactCover.interruption() == ExactCover::BudgetExhausted && exactCover.nodesVisited() == nodes,
+          "Empty (budget " + QString::number(nodes) + " nodes, searched " + QString::number(exactCover.nodesVisited()) + " nodes)");
+}
+
+// Searches of any kind reuse one exact cover problem, each starting from fixed rows only
+// (rows chosen by the previous search, found or stopped, are released first)
+static void runRepeatedSearchTests() {
+    const int threads = 2;
+    const quint64 solutions = 10;
+    qInfo() << "Running Repeated Search Tests:";
+
+    Grid sudoku;
+    for (auto &test : Tests::s9x9) {
+        if (test.title == "Not Unique — 10 Solutions") {
+            sudoku = GridFormat::fromString(test.input);
+        }
+    }
+
+    // Values fixed as in DLX (row identification order of template)
+    int size = sudoku.size();
+    int cells = size * size;
+    ExactCover exactCover(*DLX::exactCoverTemplate(size));
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (sudoku.at(i).at(j) > 0) {
+                exactCover.fixRow((i * size + j) * size + sudoku.at(i).at(j) - 1);
+            }
+        }
+    }
+
+    check(exactCover.solve() && exactCover.solution().size() == cells, "Solve");
+    check(exactCover.solve() && exactCover.solution().size() == cells, "Solve after solve");
+    check(exactCover.countSolutions() == solutions, "Count after solve");
+    check(exactCover.solvePortfolio(threads) && exactCover.solution().size() == cells, "Portfolio after count");
+    check(exactCover.countSolutions() == solutions, "Count after portfolio");
+    check(exactCover.solveParallel(threads) && exactCover.solution().size() == cells, "Parallel solve after count");
+    check(exactCover.countSolutionsParallel(0, threads) == solutions, "Parallel count after parallel solve");
+    check(exactCover.enumerateSolutions([](const ExactCover::SolutionView &) { return false; }) == 1,
+          "Stopped enumeration after parallel count");
+    check(exactCover.countSolutions() == solutions, "Count after stopped enumeration");
+
+    // Rows without columns are not added
+    ExactCover small(2);
+    int empty = small.addRow(nullptr, 0);
+    int row = small.addRow(QVector<int>{0, 1});
+    check(empty == -1 && row == 0 && small.rowCount() == 1 && small.solve() && small.solution() == QVector<int>{0},
+          "Empty row not added");
+
+    // Degree ordered search after assigning matrix with as many rows but more columns (deeper search)
+    ExactCover::Heuristic degree;
+    degree.degreeOrder = true;
+    ExactCover shallow(2);
+    shallow.setHeuristic(degree);
+    shallow.addRow(QVector<int>{0});
+    shallow.addRow(QVector<int>{1});
+    shallow.addRow(QVector<int>{0, 1});
+    ExactCover deep(3);
+    deep.addRow(QVector<int>{0});
+    deep.addRow(QVector<int>{1});
+    deep.addRow(QVector<int>{2});
+    bool solved = shallow.solve();
+    shallow = deep;
+    check(solved && shallow.solve() && shallow.solution().size() == 3, "Degree order after assignment");
+}
+
+// Counting keeps the last solution found for solution(), also once search is exhausted past it
+static void runCountSolutionTests() {
+    qInfo() << "Running Count Solution Tests:";
+
+    for (auto &test : Tests::s9x9) {
+        if (test.title != "Hard 1" && test.title != "Not Unique — 10 Solutions") {
+            continue;
+        }
+
+        Grid sudoku = GridFormat::fromString(test.input);
+        DLX dlx(sudoku);
+        quint64 count = dlx.countSolutions(2);
+        bool passed = dlx.result() == Solver::Solved && Solver::isSolution(sudoku, dlx.solution());
+        if (!test.title.startsWith("Not Unique")) {
+            passed = passed && count == 1 && GridFormat::toString(dlx.solution()) == test.expectedResult;
+        }
+        check(passed, test.title + " (solution after counting " + QString::number(count) + " of limit 2)");
+
+        count = dlx.countSolutions();
+        check(Solver::isSolution(sudoku, dlx.solution()),
+              test.title + " (solution after counting all " + QString::number(count) + ")");
+    }
+}
+
+// Every solution streamed by enumeration of empty 4x4 grid (no fixed rows, so search stack is never written
+// before enumeration starts) is a valid grid, and all of them are distinct
+static void runEnumerationTests() {
+    const int size = 4;
+    const quint64 solutions = 288;
+    qInfo() << "Running Enumeration Tests:";
+
+    Grid empty;
+    for (int i = 0; i < size; ++i) {
+        empty.append(GridRow());
+        for (int j = 0; j < size; ++j) {
+            empty[i].append(0);
+        }
+    }
+
+    DLX dlx(empty);
+    QSet<QString> grids;
+    bool valid = true;
+    quint64 count = dlx.enumerateSolutions([&](const DLX::SolutionView &view) {
+        Grid grid = empty;
+        for (int i = 0; i < view.size(); ++i) {
+            grid[view.row(i)][view.column(i)] = view.candidate(i);
+        }
+        valid = valid && view.size() == size * size && Solver::isSolution(empty, grid);
+        grids.insert(GridFormat::toString(grid));
+        return true;
+    });
+    check(valid && count == solutions && grids.size() == static_cast<int>(solutions),
+          "Empty 4x4 (" + QString::number(count) + " solutions, " + QString::number(grids.size()) + " distinct)");
+}
+
+// Perfect square sizes beyond candidate masks of solvers are rejected by text formats
+static void runGridSizeTests() {
+    qInfo() << "Running Grid Size Tests:";
+
+    check(GridFormat::isValidSize(64) && !GridFormat::isValidSize(81), "Size limit");
+    QString cells = ".";
+    for (int i = 1; i < 81 * 81; ++i) {
+        cells.append(",.");
+    }
+    check(GridFormat::fromDelimitedString(cells).isEmpty(), "Delimited 81x81");
+}
+
+// Writes packed binary puzzle file with given header fields followed by zeroed puzzle data, returns its name
+static QString writePuzzleFile(int bits, int size, quint64 count, int dataBytes) {
+    QByteArray header(PuzzleFile::HeaderSize, 0);
+    memcpy(header.data(), PuzzleFile::Magic, sizeof(PuzzleFile::Magic));
+    header[4] = static_cast<char>(PuzzleFile::Version);
+    header[5] = static_cast<char>(bits);
+    qToLittleEndian<quint16>(static_cast<quint16>(size), header.data() + 6);
+    qToLittleEndian<quint64>(count, header.data() + 8);
+
+    QString fileName = QDir::temp().filePath("SudokuDLXTests.sdlx");
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(header + QByteArray(dataBytes, 0));
+    }
+    return fileName;
+}
+
+// Packed binary puzzle files with malformed headers are rejected on open
+static void runPuzzleFileTests() {
+    qInfo() << "Running Puzzle File Tests:";
+
+    PuzzleFile file;
+    bool opened = file.open(writePuzzleFile(PuzzleFile::bitsPerCell(9), 9, 2, 2 * PuzzleFile::puzzleBytes(9)));
+    check(opened && file.size() == 9 && file.count() == 2, "Valid header");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(0), 0, 0, 0)), "Zero size");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(10), 10, 1, PuzzleFile::puzzleBytes(10))), "Non-square size");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(1), 1, 1, PuzzleFile::puzzleBytes(1))), "Size below 4");
+    check(!file.open(writePuzzleFile(9, 256, 1, PuzzleFile::puzzleBytes(256))), "Size above single byte values");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(81), 81, 1, PuzzleFile::puzzleBytes(81))), "Size above solver limit");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(9) + 1, 9, 1, PuzzleFile::puzzleBytes(9))), "Wrong bits per cell");
+    check(!file.open(writePuzzleFile(PuzzleFile::bitsPerCell(9), 9, 3, 2 * PuzzleFile::puzzleBytes(9))), "Count beyond file size");
+    file.close();
+    QFile::remove(QDir::temp().filePath("SudokuDLXTests.sdlx"));
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SudokuDLXTests");
+
+    // In-code test cases, including the 16x16 ones that take too long for GUI start
+    runTestCases("9x9", Tests::s9x9, Solver::DancingLinks, false);
+    runTestCases("16x16", Tests::s16x16, Solver::DancingLinks, false);
+    runTestCases("9x9 (bitboard)", Tests::s9x9, Solver::Bitboard, false);
+    runTestCases("9x9 (propagation)", Tests::s9x9, Solver::DancingLinks, true);
+    runTestCases("16x16 (propagation)", Tests::s16x16, Solver::DancingLinks, true);
+
+    // Solver core
+    runParallelBudgetTests("9x9", Tests::s9x9);
+    runParallelBudgetTests("16x16", Tests::s16x16);
+    runParallelBudgetCount(9);
+    runParallelBudgetCount(16);
+    runRepeatedSearchTests();
+    runCountSolutionTests();
+    runEnumerationTests();
+    runGridSizeTests();
+    runPuzzleFileTests();
+
+    if (failures != 0) {
+        qInfo() << failures << "tests FAILED or gave WRONG results!";
+        return 1;
+    }
+    qInfo() << "All tests PASSED!";
+    return 0;
+}